@@ -2,8 +2,11 @@
 #include "GameFramework/Actor.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/KismetSystemLibrary.h"
-#include "NiagaraFunctionLibrary.h"
 #include "Engine/World.h"
+#include "Engine/OverlapResult.h"
+#include "SandboxItemRegistry.h"
+#include "SandboxWorldManager.h"
+#include "SandboxPhysicsSleepSubsystem.h"
 
 UPhysicsGrabberComponent::UPhysicsGrabberComponent()
 {
@@ -29,6 +32,9 @@ void UPhysicsGrabberComponent::BeginPlay()
             PhysicsHandle->AngularDamping = 10.0f;
             PhysicsHandle->AngularStiffness = 1500.0f;
             PhysicsHandle->InterpolationSpeed = 50.0f;
+
+            // First handle of the pool, extra ones copy its settings for group grabs
+            FreeHandles.Add(PhysicsHandle);
         }
     }
 }
@@ -37,75 +43,139 @@ void UPhysicsGrabberComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-    // 1. Update UI state (Raycast check)
-    UpdateTraceState();
+    // 1. Update UI state (Raycast check, throttled)
+    UpdateTraceState(DeltaTime);
 
     // 2. Physics logic (Only if holding)
-    if (!bIsHolding || !PhysicsHandle) return;
+    if (!bIsHolding) return;
+
+    // Safety check: bodies destroyed externally leave the group
+    for (int32 BodyIndex = GrabbedBodies.Num() - 1; BodyIndex >= 0; --BodyIndex)
+    {
+        const FSandboxGrabbedBody& Body = GrabbedBodies[BodyIndex];
+        if (!Body.Handle || !Body.Handle->GetGrabbedComponent())
+        {
+            ReleaseBodyAt(BodyIndex);
+        }
+    }
 
-    // Safety check: if the component was destroyed externally
-    if (!PhysicsHandle->GetGrabbedComponent())
+    if (GrabbedBodies.Num() == 0)
     {
         ReleaseObject();
         return;
     }
 
+    // One camera read for the whole group
     FVector CameraLoc, CameraDir;
     FRotator CameraRot;
     if (!GetPlayerViewPoint(CameraLoc, CameraDir, CameraRot)) return;
 
-    // Calculate Target Position
-    FVector FinalPosition = CameraLoc + (CameraDir * CurrentHoldDistance);
-
-    // Custom Spring Physics Calculation
-    FVector Displacement = FinalPosition - CurrentTargetLocation;
-    FVector SpringForce = Displacement * SpringStiffness;
-    FVector DampingForce = CurrentTargetVelocity * SpringDamping;
-    FVector Acceleration = SpringForce - DampingForce;
+    // Calculate Target Position, the formation turns with the camera
+    const FVector HoldPoint = CameraLoc + (CameraDir * CurrentHoldDistance);
+    const FQuat CameraQuat = CameraRot.Quaternion();
 
-    CurrentTargetVelocity += Acceleration * DeltaTime;
-    CurrentTargetLocation += CurrentTargetVelocity * DeltaTime;
+    // Custom Spring Physics Calculation, in fixed steps so every frame rate gets the same response
+    const float StepTime = 1.0f / FMath::Max(SpringStepRate, 1.0f);
 
-    FRotator TargetRotation = CameraRot + RotationOffset;
+    // A hitch slows the spring down instead of feeding it one huge step
+    SpringTimeAccumulator = FMath::Min(SpringTimeAccumulator + DeltaTime, StepTime * MaxSpringStepsPerFrame);
+    while (SpringTimeAccumulator >= StepTime)
+    {
+        for (FSandboxGrabbedBody& Body : GrabbedBodies)
+        {
+            Body.PreviousTargetLocation = Body.TargetLocation;
+            StepSpring(Body, HoldPoint + CameraQuat.RotateVector(Body.FormationOffset), StepTime);
+        }
+        SpringTimeAccumulator -= StepTime;
+    }
 
-    PhysicsHandle->SetTargetLocationAndRotation(CurrentTargetLocation, TargetRotation);
+    // Blend between the last two steps, the remainder carries into the next frame
+    const float StepAlpha = SpringTimeAccumulator / StepTime;
+    for (const FSandboxGrabbedBody& Body : GrabbedBodies)
+    {
+        const FVector SmoothedTargetLocation = FMath::Lerp(Body.PreviousTargetLocation, Body.TargetLocation, StepAlpha);
+        Body.Handle->SetTargetLocationAndRotation(SmoothedTargetLocation, CameraRot + Body.RotationOffset);
+    }
 }
 
-void UPhysicsGrabberComponent::UpdateTraceState()
+void UPhysicsGrabberComponent::StepSpring(FSandboxGrabbedBody& Body, const FVector& GoalLocation, float StepTime) const
 {
-    EGrabState NewState = EGrabState::Idle;
+    FVector Displacement = GoalLocation - Body.TargetLocation;
+    FVector SpringForce = Displacement * SpringStiffness;
+    FVector DampingForce = Body.TargetVelocity * SpringDamping;
+    FVector Acceleration = SpringForce - DampingForce;
 
+    // Semi-implicit Euler: velocity first, then position with the new velocity
+    Body.TargetVelocity += Acceleration * StepTime;
+    Body.TargetLocation += Body.TargetVelocity * StepTime;
+}
+
+void UPhysicsGrabberComponent::UpdateTraceState(float DeltaTime, bool bForceTrace)
+{
     if (bIsHolding)
     {
-        NewState = EGrabState::Holding;
+        SetGrabState(EGrabState::Holding);
+        return;
     }
-    else
+
+    // OPTIMIZATION: The crosshair only needs a few updates per second, not one per rendered frame
+    TimeSinceTrace += DeltaTime;
+    if (!bForceTrace && TimeSinceTrace < TraceUpdateInterval) return;
+
+    // One trace in flight, its result lands on the next tick; the throttle restarts only when a trace is issued
+    const bool bUseAsyncTrace = bAsyncTrace && !bForceTrace;
+    if (bUseAsyncTrace && PendingTraceHandle.IsValid()) return;
+
+    FVector CamLoc, CamDir;
+    FRotator CamRot;
+    if (!GetPlayerViewPoint(CamLoc, CamDir, CamRot))
     {
-        FVector CamLoc, CamDir;
-        FRotator CamRot;
-        if (GetPlayerViewPoint(CamLoc, CamDir, CamRot))
-        {
-            FVector TraceEnd = CamLoc + (CamDir * TraceDistance);
-            FHitResult Hit;
-            FCollisionQueryParams Params;
-            Params.AddIgnoredActor(GetOwner());
+        SetGrabState(EGrabState::Idle);
+        return;
+    }
 
-            bool bHit = GetWorld()->LineTraceSingleByChannel(
-                Hit, CamLoc, TraceEnd, ECC_Visibility, Params
-            );
+    // OPTIMIZATION: A still camera keeps its state
+    const bool bCameraStill = FVector::DistSquared(CamLoc, LastTraceLocation) <= FMath::Square(TraceSkipDistance)
+        && CamRot.Equals(LastTraceRotation, TraceSkipAngle);
+    if (!bForceTrace && bHasTraced && bCameraStill && TimeSinceTrace < MaxTraceSkipTime) return;
 
-            if (bHit && Hit.GetComponent())
-            {
-                // Check tags and physics state
-                bool bHasTag = Hit.GetComponent()->ComponentHasTag(LiftableTag) || Hit.GetActor()->ActorHasTag(LiftableTag);
-                if (bHasTag && Hit.GetComponent()->IsSimulatingPhysics())
-                {
-                    NewState = EGrabState::CanGrab;
-                }
-            }
-        }
+    TimeSinceTrace = 0.0f;
+    LastTraceLocation = CamLoc;
+    LastTraceRotation = CamRot;
+    bHasTraced = true;
+
+    if (bUseAsyncTrace)
+    {
+        FCollisionQueryParams Params;
+        Params.AddIgnoredActor(GetOwner());
+
+        FTraceDelegate Delegate = FTraceDelegate::CreateUObject(this, &UPhysicsGrabberComponent::OnAsyncTraceDone);
+        PendingTraceHandle = GetWorld()->AsyncLineTraceByChannel(
+            EAsyncTraceType::Single, CamLoc, CamLoc + (CamDir * TraceDistance), ECC_Visibility, Params,
+            FCollisionResponseParams::DefaultResponseParam, &Delegate
+        );
+        return;
     }
 
+    FSandboxViewHit ViewHit;
+    const bool bCanGrab = QueryViewHit(ViewHit) && ViewHit.bHit && IsLiftableHit(ViewHit.Hit);
+    SetGrabState(bCanGrab ? EGrabState::CanGrab : EGrabState::Idle);
+}
+
+void UPhysicsGrabberComponent::OnAsyncTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+    if (Handle != PendingTraceHandle) return;
+    PendingTraceHandle = FTraceHandle();
+
+    // Grabbed or released while the trace was in flight
+    if (bIsHolding) return;
+
+    const bool bCanGrab = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit && IsLiftableHit(Datum.OutHits[0]);
+    SetGrabState(bCanGrab ? EGrabState::CanGrab : EGrabState::Idle);
+}
+
+void UPhysicsGrabberComponent::SetGrabState(EGrabState NewState)
+{
     // Broadcast only on change
     if (NewState != CurrentState)
     {
@@ -125,79 +195,256 @@ void UPhysicsGrabberComponent::ToggleGrab()
         return;
     }
 
-    FVector CamLoc, CamDir;
-    FRotator CamRot;
-    if (!GetPlayerViewPoint(CamLoc, CamDir, CamRot)) return;
+    // Usually the hit UpdateTraceState already paid for this frame; one query for the whole group
+    FSandboxViewHit ViewHit;
+    if (!QueryViewHit(ViewHit)) return;
 
-    FVector TraceEnd = CamLoc + (CamDir * TraceDistance);
-    FHitResult Hit;
-    FCollisionQueryParams Params;
-    Params.AddIgnoredActor(GetOwner());
+    const FVector CamLoc = ViewHit.ViewLocation;
+    const FRotator CamRot = ViewHit.ViewRotation;
+    FHitResult& Hit = ViewHit.Hit;
+    bool bHit = ViewHit.bHit;
 
-    bool bHit = GetWorld()->LineTraceSingleByChannel(
-        Hit, CamLoc, TraceEnd, ECC_Visibility, Params
-    );
+    if (bHit)
+    {
+        PromoteInstancedHit(Hit);
+    }
 
     if (bHit && Hit.GetComponent())
     {
         bool bHasTag = Hit.GetComponent()->ComponentHasTag(LiftableTag) || Hit.GetActor()->ActorHasTag(LiftableTag);
 
-        if (bHasTag && Hit.GetComponent()->IsSimulatingPhysics())
+        if (bHasTag && IsGrabbableBody(Hit.GetComponent()))
         {
             if (!PhysicsHandle) return;
 
             // Calculate distance
             CurrentHoldDistance = (Hit.Location - CamLoc).Size();
             CurrentHoldDistance = FMath::Clamp(CurrentHoldDistance, MinHoldDistance, TraceDistance);
+            SpringTimeAccumulator = 0.0f;
 
-            // Initialize physics state
-            CurrentTargetLocation = Hit.GetComponent()->GetComponentLocation();
-            CurrentTargetVelocity = FVector::ZeroVector;
-            RotationOffset = Hit.GetComponent()->GetComponentRotation() - CamRot;
+            // The hit body is held at the hit point, group members keep their place around it
+            GrabBody(Hit.GetComponent(), Hit.Location, CamRot);
 
-            PhysicsHandle->GrabComponentAtLocationWithRotation(
-                Hit.GetComponent(),
-                NAME_None,
-                Hit.Location,
-                Hit.GetComponent()->GetComponentRotation()
-            );
-
-            // Spawn VFX
-            if (GrabVFXTemplate)
+            if (MaxGrabbedObjects > 1)
             {
-                ActiveVFX = UNiagaraFunctionLibrary::SpawnSystemAttached(
-                    GrabVFXTemplate,
-                    Hit.GetComponent(),
-                    NAME_None,
-                    FVector::ZeroVector,
-                    FRotator::ZeroRotator,
-                    EAttachLocation::KeepRelativeOffset,
-                    true
-                );
+                TArray<UPrimitiveComponent*> Neighbours;
+                FindGroupBodies(Hit.GetComponent(), Neighbours);
+                for (UPrimitiveComponent* Neighbour : Neighbours)
+                {
+                    GrabBody(Neighbour, Neighbour->GetComponentLocation(), CamRot);
+                    GrabbedBodies.Last().FormationOffset = CamRot.UnrotateVector(Neighbour->GetComponentLocation() - Hit.Location);
+                }
             }
 
             bIsHolding = true;
-            UpdateTraceState(); // Immediate update
+            UpdateTraceState(0.0f, true); // Immediate update
         }
     }
 }
 
-void UPhysicsGrabberComponent::ReleaseObject()
+void UPhysicsGrabberComponent::GrabBody(UPrimitiveComponent* Component, const FVector& GrabLocation, const FRotator& CameraRotation)
 {
-    if (PhysicsHandle && PhysicsHandle->GetGrabbedComponent())
+    // Frozen items simulate again before the handle takes them
+    if (USandboxPhysicsSleepSubsystem* SleepSubsystem = USandboxPhysicsSleepSubsystem::Get(this))
     {
-        PhysicsHandle->GetGrabbedComponent()->WakeAllRigidBodies();
-        PhysicsHandle->ReleaseComponent();
+        SleepSubsystem->UnfreezeComponent(Component);
     }
 
-    if (ActiveVFX)
+    FSandboxGrabbedBody& Body = GrabbedBodies.AddDefaulted_GetRef();
+    Body.Handle = AcquireHandle();
+    Body.Component = Component;
+
+    // Initialize physics state
+    Body.TargetLocation = Component->GetComponentLocation();
+    Body.PreviousTargetLocation = Body.TargetLocation;
+    Body.TargetVelocity = FVector::ZeroVector;
+    Body.RotationOffset = Component->GetComponentRotation() - CameraRotation;
+
+    Body.Handle->GrabComponentAtLocationWithRotation(
+        Component,
+        NAME_None,
+        GrabLocation,
+        Component->GetComponentRotation()
+    );
+
+    // Attach VFX (pooled, returned on release)
+    if (GrabVFXTemplate)
     {
-        ActiveVFX->DestroyComponent();
-        ActiveVFX = nullptr;
+        Body.VFX = AcquireGrabVFX(Component);
+    }
+}
+
+void UPhysicsGrabberComponent::FindGroupBodies(UPrimitiveComponent* PrimaryComponent, TArray<UPrimitiveComponent*>& OutBodies) const
+{
+    const FVector Center = PrimaryComponent->GetComponentLocation();
+
+    FCollisionQueryParams Params;
+    Params.AddIgnoredActor(GetOwner());
+
+    TArray<FOverlapResult> Overlaps;
+    GetWorld()->OverlapMultiByObjectType(
+        Overlaps, Center, FQuat::Identity,
+        FCollisionObjectQueryParams(FCollisionObjectQueryParams::AllDynamicObjects),
+        FCollisionShape::MakeSphere(GroupGrabRadius), Params
+    );
+
+    for (const FOverlapResult& Overlap : Overlaps)
+    {
+        UPrimitiveComponent* Component = Overlap.GetComponent();
+        if (!Component || Component == PrimaryComponent || OutBodies.Contains(Component)) continue;
+
+        const bool bHasTag = Component->ComponentHasTag(LiftableTag) || (Overlap.GetActor() && Overlap.GetActor()->ActorHasTag(LiftableTag));
+        if (bHasTag && IsGrabbableBody(Component))
+        {
+            OutBodies.Add(Component);
+        }
+    }
+
+    // Nearest first when the group is larger than the grabber can hold
+    OutBodies.Sort([&Center](const UPrimitiveComponent& A, const UPrimitiveComponent& B)
+    {
+        return FVector::DistSquared(A.GetComponentLocation(), Center) < FVector::DistSquared(B.GetComponentLocation(), Center);
+    });
+
+    if (OutBodies.Num() > MaxGrabbedObjects - 1)
+    {
+        OutBodies.SetNum(MaxGrabbedObjects - 1);
+    }
+}
+
+void UPhysicsGrabberComponent::ReleaseObject()
+{
+    for (int32 BodyIndex = GrabbedBodies.Num() - 1; BodyIndex >= 0; --BodyIndex)
+    {
+        ReleaseBodyAt(BodyIndex);
     }
 
     bIsHolding = false;
-    UpdateTraceState();
+    UpdateTraceState(0.0f, true);
+}
+
+void UPhysicsGrabberComponent::ReleaseBodyAt(int32 BodyIndex)
+{
+    FSandboxGrabbedBody& Body = GrabbedBodies[BodyIndex];
+
+    if (Body.Handle && Body.Handle->GetGrabbedComponent())
+    {
+        UPrimitiveComponent* Released = Body.Handle->GetGrabbedComponent();
+        Released->WakeAllRigidBodies();
+        Body.Handle->ReleaseComponent();
+
+        // Watched until it comes to rest, then frozen
+        if (USandboxPhysicsSleepSubsystem* SleepSubsystem = USandboxPhysicsSleepSubsystem::Get(this))
+        {
+            SleepSubsystem->WatchComponent(Released);
+        }
+    }
+
+    ReleaseGrabVFX(Body.VFX);
+
+    ReleaseHandle(Body.Handle);
+    GrabbedBodies.RemoveAtSwap(BodyIndex, 1, EAllowShrinking::No);
+}
+
+UNiagaraComponent* UPhysicsGrabberComponent::AcquireGrabVFX(UPrimitiveComponent* AttachTo)
+{
+    UNiagaraComponent* VFX = nullptr;
+    while (FreeVFX.Num() > 0 && !VFX)
+    {
+        UNiagaraComponent* Candidate = FreeVFX.Pop(EAllowShrinking::No);
+        if (IsValid(Candidate))
+        {
+            VFX = Candidate;
+        }
+    }
+
+    if (VFX)
+    {
+        VFXReused++;
+        if (VFX->GetAsset() != GrabVFXTemplate)
+        {
+            VFX->SetAsset(GrabVFXTemplate);
+        }
+    }
+    else
+    {
+        // Owned by our actor, not the held item, so it survives the item being destroyed
+        VFXSpawned++;
+        VFX = NewObject<UNiagaraComponent>(GetOwner(), NAME_None, RF_Transient);
+        VFX->SetAsset(GrabVFXTemplate);
+        VFX->SetAutoActivate(false);
+        VFX->SetAutoDestroy(false);
+        VFX->RegisterComponent();
+    }
+
+    VFX->AttachToComponent(AttachTo, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+    VFX->Activate(true);
+    return VFX;
+}
+
+void UPhysicsGrabberComponent::ReleaseGrabVFX(UNiagaraComponent* VFX)
+{
+    if (!IsValid(VFX)) return;
+
+    VFX->DeactivateImmediate();
+    VFX->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+
+    if (FreeVFX.Num() < MaxPooledVFX)
+    {
+        FreeVFX.Add(VFX);
+    }
+    else
+    {
+        VFX->DestroyComponent();
+    }
+}
+
+UPhysicsHandleComponent* UPhysicsGrabberComponent::AcquireHandle()
+{
+    UPhysicsHandleComponent* Handle = nullptr;
+    if (FreeHandles.Num() > 0)
+    {
+        Handle = FreeHandles.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        // Not templated on the owner's handle, it may be holding the aimed body right now
+        Handle = NewObject<UPhysicsHandleComponent>(GetOwner(), NAME_None, RF_Transient);
+        CopyHandleSettings(Handle);
+        Handle->RegisterComponent();
+    }
+
+    if (Handle != PhysicsHandle)
+    {
+        Handle->SetComponentTickEnabled(true);
+    }
+    return Handle;
+}
+
+void UPhysicsGrabberComponent::ReleaseHandle(UPhysicsHandleComponent* Handle)
+{
+    if (!Handle) return;
+
+    // Idle pooled handles do not tick; the owner's handle may be driven by Blueprint as well
+    if (Handle != PhysicsHandle)
+    {
+        Handle->SetComponentTickEnabled(false);
+    }
+    FreeHandles.Add(Handle);
+}
+
+void UPhysicsGrabberComponent::CopyHandleSettings(UPhysicsHandleComponent* Handle) const
+{
+    if (!PhysicsHandle) return;
+
+    Handle->bSoftAngularConstraint = PhysicsHandle->bSoftAngularConstraint;
+    Handle->bSoftLinearConstraint = PhysicsHandle->bSoftLinearConstraint;
+    Handle->bInterpolateTarget = PhysicsHandle->bInterpolateTarget;
+    Handle->LinearDamping = PhysicsHandle->LinearDamping;
+    Handle->LinearStiffness = PhysicsHandle->LinearStiffness;
+    Handle->AngularDamping = PhysicsHandle->AngularDamping;
+    Handle->AngularStiffness = PhysicsHandle->AngularStiffness;
+    Handle->InterpolationSpeed = PhysicsHandle->InterpolationSpeed;
 }
 
 void UPhysicsGrabberComponent::ChangeHoldDistance(float AxisValue)
@@ -210,17 +457,86 @@ void UPhysicsGrabberComponent::ChangeHoldDistance(float AxisValue)
 
 bool UPhysicsGrabberComponent::GetPlayerViewPoint(FVector& OutLoc, FVector& OutDir, FRotator& OutRot) const
 {
-    if (APawn* Pawn = Cast<APawn>(GetOwner()))
+    if (APlayerController* PC = GetOwningPlayerController())
     {
-        if (AController* C = Pawn->GetController())
-        {
-            if (APlayerController* PC = Cast<APlayerController>(C))
-            {
-                PC->GetPlayerViewPoint(OutLoc, OutRot);
-                OutDir = OutRot.Vector();
-                return true;
-            }
-        }
+        PC->GetPlayerViewPoint(OutLoc, OutRot);
+        OutDir = OutRot.Vector();
+        return true;
     }
     return false;
+}
+
+APlayerController* UPhysicsGrabberComponent::GetOwningPlayerController() const
+{
+    if (APawn* Pawn = Cast<APawn>(GetOwner()))
+    {
+        return Cast<APlayerController>(Pawn->GetController());
+    }
+    return nullptr;
+}
+
+bool UPhysicsGrabberComponent::QueryViewHit(FSandboxViewHit& OutViewHit, bool bForceFresh) const
+{
+    APlayerController* PC = GetOwningPlayerController();
+    if (!PC) return false;
+
+    if (USandboxViewQuerySubsystem* ViewQuery = USandboxViewQuerySubsystem::Get(this))
+    {
+        return ViewQuery->GetViewHit(PC, TraceDistance, OutViewHit, bForceFresh);
+    }
+
+    // Worlds without the subsystem trace directly
+    PC->GetPlayerViewPoint(OutViewHit.ViewLocation, OutViewHit.ViewRotation);
+    OutViewHit.TraceDistance = TraceDistance;
+
+    FVector TraceEnd = OutViewHit.ViewLocation + (OutViewHit.ViewRotation.Vector() * TraceDistance);
+    FCollisionQueryParams Params;
+    Params.AddIgnoredActor(GetOwner());
+
+    OutViewHit.bHit = GetWorld()->LineTraceSingleByChannel(
+        OutViewHit.Hit, OutViewHit.ViewLocation, TraceEnd, ECC_Visibility, Params
+    );
+    return true;
+}
+
+void UPhysicsGrabberComponent::PromoteInstancedHit(FHitResult& Hit) const
+{
+    // Only liftable instances are worth turning back into actors
+    UPrimitiveComponent* HitComponent = Hit.GetComponent();
+    if (!HitComponent || Hit.Item == INDEX_NONE || !HitComponent->ComponentHasTag(LiftableTag)) return;
+
+    USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this);
+    ASandboxWorldManager* Manager = Registry ? Registry->GetWorldManager() : nullptr;
+    AActor* Promoted = Manager ? Manager->PromoteInstancedHit(Hit) : nullptr;
+    if (!Promoted) return;
+
+    // Retarget the hit to the promoted actor's body
+    if (UPrimitiveComponent* PromotedComponent = Cast<UPrimitiveComponent>(Promoted->GetRootComponent()))
+    {
+        Hit = FHitResult(Promoted, PromotedComponent, Hit.Location, Hit.Normal);
+    }
+}
+
+bool UPhysicsGrabberComponent::IsLiftableHit(const FHitResult& Hit) const
+{
+    UPrimitiveComponent* HitComponent = Hit.GetComponent();
+    if (!HitComponent) return false;
+
+    // Check tags and physics state (kinematic-frozen items are still grabbable)
+    const bool bHasTag = HitComponent->ComponentHasTag(LiftableTag) || (Hit.GetActor() && Hit.GetActor()->ActorHasTag(LiftableTag));
+    if (!bHasTag) return false;
+    if (IsGrabbableBody(HitComponent)) return true;
+
+    // Instanced items turn back into actors only when actually grabbed
+    const USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this);
+    const ASandboxWorldManager* Manager = Registry ? Registry->GetWorldManager() : nullptr;
+    return Manager && Manager->IsInstancedItemHit(Hit);
+}
+
+bool UPhysicsGrabberComponent::IsGrabbableBody(const UPrimitiveComponent* Component) const
+{
+    if (Component->IsSimulatingPhysics()) return true;
+
+    const USandboxPhysicsSleepSubsystem* SleepSubsystem = USandboxPhysicsSleepSubsystem::Get(this);
+    return SleepSubsystem && SleepSubsystem->IsFrozen(Component);
 }
\ No newline at end of file
@@ -1,12 +1,17 @@
 #include "SandboxDestructionAudio.h"
+#include "SandboxDestructionAudioSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
 #include "GeometryCollection/GeometryCollectionComponent.h" 
 #include "Chaos/ChaosGameplayEventDispatcher.h"
 
 USandboxDestructionAudio::USandboxDestructionAudio()
 {
-    PrimaryComponentTick.bCanEverTick = false;
+    // Ticks only on frames that received breaks
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
 }
 
 void USandboxDestructionAudio::BeginPlay()
@@ -16,21 +21,36 @@ void USandboxDestructionAudio::BeginPlay()
     AActor* Owner = GetOwner();
     if (!Owner) return;
 
-    UGeometryCollectionComponent* GeometryCollection = Owner->FindComponentByClass<UGeometryCollectionComponent>();
-    if (GeometryCollection)
+    GeometryCollection = Owner->FindComponentByClass<UGeometryCollectionComponent>();
+    if (!GeometryCollection.IsValid()) return;
+
+    // OPTIMIZATION: Distant collections generate cluster-level events or none, the subsystem re-evaluates as the player moves
+    USandboxDestructionAudioSubsystem* AudioSubsystem = bUseSignificanceLOD ? USandboxDestructionAudioSubsystem::Get(this) : nullptr;
+    if (AudioSubsystem)
+    {
+        AudioSubsystem->RegisterDestructionAudio(this);
+    }
+    else
     {
-        GeometryCollection->SetNotifyBreaks(true);
-        GeometryCollection->OnChaosBreakEvent.AddDynamic(this, &USandboxDestructionAudio::HandleBreakEvent);
+        SetNotifyLevel(ESandboxBreakNotifyLevel::Full);
     }
 }
 
-void USandboxDestructionAudio::HandleBreakEvent(const FChaosBreakEvent& BreakEvent)
+void USandboxDestructionAudio::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    if (!IsValid(this) || !GetWorld()) return;
-    if (!BreakSound) return;
+    if (USandboxDestructionAudioSubsystem* AudioSubsystem = USandboxDestructionAudioSubsystem::Get(this))
+    {
+        AudioSubsystem->UnregisterDestructionAudio(this);
+    }
 
-    // Timer logic to stop listening after major destruction
-    if (!bIsActive)
+    PendingBreaks.Reset();
+    Super::EndPlay(EndPlayReason);
+}
+
+void USandboxDestructionAudio::HandleBreakEvent(const FChaosBreakEvent& BreakEvent)
+{
+    // Timer logic to stop listening after major destruction, started by the first raw event before any filter
+    if (!bIsActive && GetWorld())
     {
         bIsActive = true;
 
@@ -45,28 +65,131 @@ void USandboxDestructionAudio::HandleBreakEvent(const FChaosBreakEvent& BreakEve
         );
     }
 
-    float CurrentTime = GetWorld()->GetTimeSeconds();
-    if (CurrentTime - LastSoundTime < MinTimeBetweenSounds)
+    // OPTIMIZATION: Per fragment only the event's own fields are read, everything else runs once per frame
+    if (BreakEvent.Mass < MinBreakMass) return;
+    if (MinBreakSpeed > 0.0f && BreakEvent.Velocity.SizeSquared() < FMath::Square(MinBreakSpeed)) return;
+
+    if (PendingBreaks.Num() == 0)
     {
-        return;
+        if (!BreakSound && !OnBreakBatch.IsBound()) return;
+        SetComponentTickEnabled(true);
     }
+    PendingBreaks.Add(BreakEvent);
+}
+
+void USandboxDestructionAudio::HandleCrumblingEvent(const FChaosCrumblingEvent& CrumblingEvent)
+{
+    // A whole cluster came apart, heard as a single break at its centre
+    FChaosBreakEvent BreakEvent;
+    BreakEvent.Component = CrumblingEvent.Component;
+    BreakEvent.Location = CrumblingEvent.Location;
+    BreakEvent.Velocity = CrumblingEvent.LinearVelocity;
+    BreakEvent.AngularVelocity = CrumblingEvent.AngularVelocity;
+    BreakEvent.Mass = CrumblingEvent.Mass;
 
-    UGameplayStatics::PlaySoundAtLocation(this, BreakSound, BreakEvent.Location);
-    LastSoundTime = CurrentTime;
+    HandleBreakEvent(BreakEvent);
 }
 
-void USandboxDestructionAudio::ShutdownAudioLogic()
+void USandboxDestructionAudio::SetNotifyLevel(ESandboxBreakNotifyLevel Level)
 {
-    if (!IsValid(this)) return;
+    UGeometryCollectionComponent* Collection = GeometryCollection.Get();
+    if (!Collection || bShutdown || Level == NotifyLevel) return;
 
-    AActor* Owner = GetOwner();
-    if (!IsValid(Owner)) return;
+    const bool bWantBreaks = Level == ESandboxBreakNotifyLevel::Full;
+    if (bWantBreaks != (NotifyLevel == ESandboxBreakNotifyLevel::Full))
+    {
+        Collection->SetNotifyBreaks(bWantBreaks);
+        if (bWantBreaks)
+        {
+            Collection->OnChaosBreakEvent.AddUniqueDynamic(this, &USandboxDestructionAudio::HandleBreakEvent);
+        }
+        else
+        {
+            Collection->OnChaosBreakEvent.RemoveDynamic(this, &USandboxDestructionAudio::HandleBreakEvent);
+        }
+    }
+
+    const bool bWantCrumblings = Level == ESandboxBreakNotifyLevel::Crumbling;
+    if (bWantCrumblings != (NotifyLevel == ESandboxBreakNotifyLevel::Crumbling))
+    {
+        Collection->SetNotifyCrumblings(bWantCrumblings);
+        if (bWantCrumblings)
+        {
+            Collection->OnChaosCrumblingEvent.AddUniqueDynamic(this, &USandboxDestructionAudio::HandleCrumblingEvent);
+        }
+        else
+        {
+            Collection->OnChaosCrumblingEvent.RemoveDynamic(this, &USandboxDestructionAudio::HandleCrumblingEvent);
+        }
+    }
 
-    UGeometryCollectionComponent* GeometryCollection = Owner->FindComponentByClass<UGeometryCollectionComponent>();
+    NotifyLevel = Level;
+}
+
+void USandboxDestructionAudio::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    ProcessBreakBatch();
+    SetComponentTickEnabled(false);
+}
+
+void USandboxDestructionAudio::ProcessBreakBatch()
+{
+    if (PendingBreaks.Num() == 0 || !GetWorld()) return;
+
+    if (MaxListenerDistance > 0.0f)
+    {
+        FVector ListenerLocation, ListenerFront, ListenerRight;
+        APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0);
+        if (PlayerController)
+        {
+            PlayerController->GetAudioListenerPosition(ListenerLocation, ListenerFront, ListenerRight);
+
+            const float MaxDistanceSq = FMath::Square(MaxListenerDistance);
+            PendingBreaks.RemoveAllSwap([&](const FChaosBreakEvent& Break)
+            {
+                return FVector::DistSquared(Break.Location, ListenerLocation) > MaxDistanceSq;
+            }, EAllowShrinking::No);
+        }
+    }
 
-    if (GeometryCollection && GeometryCollection->IsValidLowLevel())
+    if (PendingBreaks.Num() > 0)
     {
-        GeometryCollection->OnChaosBreakEvent.RemoveDynamic(this, &USandboxDestructionAudio::HandleBreakEvent);
-        GeometryCollection->SetNotifyBreaks(false);
+        OnBreakBatch.Broadcast(PendingBreaks);
     }
+
+    if (BreakSound && PendingBreaks.Num() > 0)
+    {
+        // OPTIMIZATION: Every break counts towards its cluster's size, the subsystem decides what is heard
+        if (USandboxDestructionAudioSubsystem* AudioSubsystem = USandboxDestructionAudioSubsystem::Get(this))
+        {
+            for (const FChaosBreakEvent& Break : PendingBreaks)
+            {
+                AudioSubsystem->SubmitBreak(BreakSound, BigBreakSound, Break.Location);
+            }
+        }
+        else
+        {
+            float CurrentTime = GetWorld()->GetTimeSeconds();
+            if (CurrentTime - LastSoundTime >= MinTimeBetweenSounds)
+            {
+                UGameplayStatics::PlaySoundAtLocation(this, BreakSound, PendingBreaks[0].Location);
+                LastSoundTime = CurrentTime;
+            }
+        }
+    }
+
+    PendingBreaks.Reset();
+}
+
+void USandboxDestructionAudio::ShutdownAudioLogic()
+{
+    if (!IsValid(this)) return;
+
+    // Stays off, the significance update skips shut down components
+    SetNotifyLevel(ESandboxBreakNotifyLevel::Off);
+    bShutdown = true;
+
+    PendingBreaks.Reset();
 }
\ No newline at end of file
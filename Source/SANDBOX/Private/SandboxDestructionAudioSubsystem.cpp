@@ -0,0 +1,189 @@
+#include "SandboxDestructionAudioSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/PlayerController.h"
+#include "Sound/SoundBase.h"
+#include "Engine/World.h"
+
+USandboxDestructionAudioSubsystem* USandboxDestructionAudioSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<USandboxDestructionAudioSubsystem>() : nullptr;
+}
+
+bool USandboxDestructionAudioSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USandboxDestructionAudioSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USandboxDestructionAudioSubsystem, STATGROUP_Tickables);
+}
+
+void USandboxDestructionAudioSubsystem::SubmitBreak(USoundBase* Sound, USoundBase* BigBreakSound, const FVector& Location)
+{
+    if (!Sound) return;
+
+    EventsReceived++;
+
+    if (WindowStartTime < 0.0)
+    {
+        WindowStartTime = GetWorld()->GetTimeSeconds();
+    }
+
+    const FIntVector Cell(
+        FMath::FloorToInt(Location.X / ClusterRadius),
+        FMath::FloorToInt(Location.Y / ClusterRadius),
+        FMath::FloorToInt(Location.Z / ClusterRadius));
+
+    // OPTIMIZATION: One cell lookup per event, a collapsing tower feeds a handful of clusters
+    const TPair<TObjectKey<USoundBase>, FIntVector> Key(Sound, Cell);
+    int32& ClusterIndex = ClusterIndexByCell.FindOrAdd(Key, INDEX_NONE);
+    if (ClusterIndex == INDEX_NONE)
+    {
+        ClusterIndex = Clusters.AddDefaulted();
+        Clusters[ClusterIndex].Sound = Sound;
+    }
+
+    FBreakCluster& Cluster = Clusters[ClusterIndex];
+    Cluster.LocationSum += Location;
+    Cluster.Count++;
+    if (BigBreakSound)
+    {
+        Cluster.BigBreakSound = BigBreakSound;
+    }
+}
+
+void USandboxDestructionAudioSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    TimeSinceSignificanceUpdate += DeltaTime;
+    if (TimeSinceSignificanceUpdate >= SignificanceInterval && AudioComponents.Num() > 0)
+    {
+        UpdateSignificance();
+    }
+
+    if (WindowStartTime >= 0.0 && GetWorld()->GetTimeSeconds() - WindowStartTime >= WindowDuration)
+    {
+        FlushWindow();
+    }
+}
+
+void USandboxDestructionAudioSubsystem::FlushWindow()
+{
+    // Largest clusters are the ones worth hearing
+    Clusters.Sort([](const FBreakCluster& A, const FBreakCluster& B)
+    {
+        return A.Count > B.Count;
+    });
+
+    const int32 VoiceCount = FMath::Min(Clusters.Num(), MaxVoicesPerWindow);
+    for (int32 ClusterIndex = 0; ClusterIndex < VoiceCount; ++ClusterIndex)
+    {
+        const FBreakCluster& Cluster = Clusters[ClusterIndex];
+
+        USoundBase* Sound = Cluster.Sound.Get();
+        if (Cluster.Count >= BigBreakThreshold && Cluster.BigBreakSound.IsValid())
+        {
+            Sound = Cluster.BigBreakSound.Get();
+        }
+        if (!Sound) continue;
+
+        const float Volume = FMath::Min(1.0f + VolumePerDoubling * FMath::Log2((float)Cluster.Count), MaxVolumeMultiplier);
+        UGameplayStatics::PlaySoundAtLocation(this, Sound, Cluster.LocationSum / Cluster.Count, Volume);
+        VoicesPlayed++;
+    }
+
+    ClustersDropped += Clusters.Num() - VoiceCount;
+
+    Clusters.Reset();
+    ClusterIndexByCell.Reset();
+    WindowStartTime = -1.0;
+}
+
+// =========================================================================
+// SIGNIFICANCE
+// =========================================================================
+
+void USandboxDestructionAudioSubsystem::RegisterDestructionAudio(USandboxDestructionAudio* AudioComponent)
+{
+    if (!IsValid(AudioComponent)) return;
+
+    AudioComponents.AddUnique(AudioComponent);
+
+    // Without a listener yet there is nothing to measure against, behave as before
+    FVector ListenerLocation;
+    const ESandboxBreakNotifyLevel Level = GetListenerLocation(ListenerLocation)
+        ? EvaluateSignificance(AudioComponent, ListenerLocation)
+        : ESandboxBreakNotifyLevel::Full;
+    AudioComponent->SetNotifyLevel(Level);
+}
+
+void USandboxDestructionAudioSubsystem::UnregisterDestructionAudio(USandboxDestructionAudio* AudioComponent)
+{
+    AudioComponents.RemoveSingleSwap(AudioComponent, EAllowShrinking::No);
+}
+
+void USandboxDestructionAudioSubsystem::UpdateSignificance()
+{
+    TimeSinceSignificanceUpdate = 0.0f;
+
+    FVector ListenerLocation;
+    if (!GetListenerLocation(ListenerLocation)) return;
+
+    FullNotifyCount = 0;
+    CrumblingNotifyCount = 0;
+
+    for (int32 Index = AudioComponents.Num() - 1; Index >= 0; --Index)
+    {
+        USandboxDestructionAudio* AudioComponent = AudioComponents[Index].Get();
+        if (!AudioComponent || AudioComponent->IsShutdown())
+        {
+            AudioComponents.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+            continue;
+        }
+
+        const ESandboxBreakNotifyLevel Level = EvaluateSignificance(AudioComponent, ListenerLocation);
+        AudioComponent->SetNotifyLevel(Level);
+
+        FullNotifyCount += Level == ESandboxBreakNotifyLevel::Full ? 1 : 0;
+        CrumblingNotifyCount += Level == ESandboxBreakNotifyLevel::Crumbling ? 1 : 0;
+    }
+}
+
+bool USandboxDestructionAudioSubsystem::GetListenerLocation(FVector& OutLocation) const
+{
+    APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0);
+    if (!PlayerController) return false;
+
+    FVector ListenerFront, ListenerRight;
+    PlayerController->GetAudioListenerPosition(OutLocation, ListenerFront, ListenerRight);
+    return true;
+}
+
+ESandboxBreakNotifyLevel USandboxDestructionAudioSubsystem::EvaluateSignificance(const USandboxDestructionAudio* AudioComponent, const FVector& ListenerLocation) const
+{
+    const UGeometryCollectionComponent* Collection = AudioComponent->GetGeometryCollection();
+    if (!Collection) return ESandboxBreakNotifyLevel::Off;
+
+    // Measured to the bounds, a large collection is heard from its near edge
+    const FBoxSphereBounds& Bounds = Collection->Bounds;
+    const float Distance = FMath::Max((float)FVector::Dist(Bounds.Origin, ListenerLocation) - (float)Bounds.SphereRadius, 1.0f);
+    const float Significance = (float)Bounds.SphereRadius / Distance;
+
+    // The current level is kept a little past the radius that granted it, so walking the edge does not toggle it
+    const ESandboxBreakNotifyLevel Current = AudioComponent->GetNotifyLevel();
+    const float FullScale = Current == ESandboxBreakNotifyLevel::Full ? 1.0f + SignificanceHysteresis : 1.0f;
+    const float CrumblingScale = Current != ESandboxBreakNotifyLevel::Off ? 1.0f + SignificanceHysteresis : 1.0f;
+
+    if (Distance <= AudibleRadius * FullScale || Significance * FullScale >= FullSignificance)
+    {
+        return ESandboxBreakNotifyLevel::Full;
+    }
+    if (Distance <= CrumblingRadius * CrumblingScale)
+    {
+        return ESandboxBreakNotifyLevel::Crumbling;
+    }
+    return ESandboxBreakNotifyLevel::Off;
+}
\ No newline at end of file
@@ -1,4 +1,9 @@
 #include "SandboxIdentityComponent.h"
+#include "SandboxItemRegistry.h"
+#include "SandboxWorldManager.h"
+#include "SandboxPhysicsSleepSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
 
 USandboxIdentityComponent::USandboxIdentityComponent()
 {
@@ -6,15 +11,117 @@ USandboxIdentityComponent::USandboxIdentityComponent()
     CurrentHealth = 100.0f;
 }
 
+void USandboxIdentityComponent::OnRegister()
+{
+    Super::OnRegister();
+
+    if (USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this))
+    {
+        Registry->RegisterItem(this);
+    }
+}
+
+void USandboxIdentityComponent::OnUnregister()
+{
+    if (USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this))
+    {
+        Registry->UnregisterItem(this);
+    }
+
+    Super::OnUnregister();
+}
+
+void USandboxIdentityComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Moving (including physics) marks the item for the next incremental save
+    AActor* Owner = GetOwner();
+    if (Owner && Owner->GetRootComponent())
+    {
+        TransformUpdatedHandle = Owner->GetRootComponent()->TransformUpdated.AddUObject(this, &USandboxIdentityComponent::OnOwnerTransformUpdated);
+    }
+}
+
+void USandboxIdentityComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    AActor* Owner = GetOwner();
+    if (Owner && Owner->GetRootComponent())
+    {
+        Owner->GetRootComponent()->TransformUpdated.Remove(TransformUpdatedHandle);
+    }
+    TransformUpdatedHandle.Reset();
+
+    // Only gameplay destruction counts as removal, not level teardown
+    if (EndPlayReason == EEndPlayReason::Destroyed)
+    {
+        if (USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this))
+        {
+            Registry->NotifyItemDestroyed(this);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void USandboxIdentityComponent::OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    if (!bSaveDirty)
+    {
+        MarkSaveDirty();
+    }
+}
+
+void USandboxIdentityComponent::MarkSaveDirty()
+{
+    if (USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this))
+    {
+        Registry->MarkDirty(this);
+    }
+}
+
+void USandboxIdentityComponent::SetSourceItemData(USandboxItemData* NewData)
+{
+    if (SourceItemData == NewData) return;
+
+    SourceItemData = NewData;
+    MarkSaveDirty();
+}
+
 void USandboxIdentityComponent::TakeDamageFromPlayer(float Amount)
 {
     if (!SourceItemData) return;
 
     CurrentHealth -= Amount;
+    MarkSaveDirty();
+
+    // Frozen items react to the hit again
+    if (USandboxPhysicsSleepSubsystem* SleepSubsystem = USandboxPhysicsSleepSubsystem::Get(this))
+    {
+        SleepSubsystem->UnfreezeActor(GetOwner());
+    }
 
     // If destroyed, nullify data to prevent saving broken objects
     if (CurrentHealth <= 0.0f)
     {
         SourceItemData = nullptr;
     }
+}
+
+USandboxIdentityComponent* USandboxIdentityComponent::ResolveHitItem(const FHitResult& Hit)
+{
+    AActor* HitActor = Hit.GetActor();
+    if (!HitActor) return nullptr;
+
+    if (USandboxIdentityComponent* Identity = HitActor->FindComponentByClass<USandboxIdentityComponent>())
+    {
+        return Identity;
+    }
+
+    // Instanced items have no actor of their own until promoted
+    USandboxItemRegistry* Registry = USandboxItemRegistry::Get(HitActor);
+    ASandboxWorldManager* Manager = Registry ? Registry->GetWorldManager() : nullptr;
+    AActor* Promoted = Manager ? Manager->PromoteInstancedHit(Hit) : nullptr;
+
+    return Promoted ? Promoted->FindComponentByClass<USandboxIdentityComponent>() : nullptr;
 }
\ No newline at end of file
@@ -1,6 +1,145 @@
 #include "SandboxItemData.h"
+#include "Engine/StaticMesh.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "UObject/ObjectSaveContext.h"
+
+// =========================================================================
+// PLACEMENT SHAPE
+// =========================================================================
+
+FSandboxPlacementShape FSandboxPlacementShape::MakeBox(const FBox& LocalBounds)
+{
+    FSandboxPlacementShape Shape;
+    Shape.Type = ESandboxPlacementShapeType::Box;
+    Shape.Center = LocalBounds.GetCenter();
+    Shape.Extent = LocalBounds.GetExtent();
+    return Shape;
+}
+
+FSandboxPlacementShape FSandboxPlacementShape::MakeSphere(const FBox& LocalBounds)
+{
+    FSandboxPlacementShape Shape;
+    Shape.Type = ESandboxPlacementShapeType::Sphere;
+    Shape.Center = LocalBounds.GetCenter();
+    Shape.Extent = FVector(LocalBounds.GetExtent().Size(), 0.0f, 0.0f);
+    return Shape;
+}
+
+FCollisionShape FSandboxPlacementShape::MakeCollisionShape(const FVector& Scale, float ShrinkFactor) const
+{
+    const FVector AbsScale = Scale.GetAbs();
+
+    switch (Type)
+    {
+    case ESandboxPlacementShapeType::Sphere:
+        return FCollisionShape::MakeSphere(Extent.X * AbsScale.GetMax() * ShrinkFactor);
+
+    case ESandboxPlacementShapeType::Capsule:
+        return FCollisionShape::MakeCapsule(Extent.X * FMath::Max(AbsScale.X, AbsScale.Y) * ShrinkFactor, Extent.Z * AbsScale.Z * ShrinkFactor);
+
+    case ESandboxPlacementShapeType::Box:
+    default:
+        return FCollisionShape::MakeBox(Extent * AbsScale * ShrinkFactor);
+    }
+}
+
+void FSandboxPlacementShape::GetWorldPose(const FTransform& ItemTransform, FVector& OutCenter, FQuat& OutRotation) const
+{
+    OutCenter = ItemTransform.TransformPosition(Center);
+    OutRotation = ItemTransform.GetRotation() * Rotation;
+}
+
+// =========================================================================
+// ITEM DATA
+// =========================================================================
 
 FPrimaryAssetId USandboxItemData::GetPrimaryAssetId() const
 {
     return FPrimaryAssetId("SandboxItemData", GetFName());
+}
+
+void USandboxItemData::PostLoad()
+{
+    Super::PostLoad();
+
+    // Assets saved before placement data existed: fill it if the mesh is already resident, never load it here
+    if (!HasPlacementData())
+    {
+        RefreshPlacementData(false);
+    }
+}
+
+#if WITH_EDITOR
+void USandboxItemData::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+    Super::PreSave(ObjectSaveContext);
+
+    // Also runs on cook, so packaged builds never compute it at runtime
+    RefreshPlacementData(true);
+}
+
+void USandboxItemData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+    if (PropertyName == GET_MEMBER_NAME_CHECKED(USandboxItemData, GhostMesh) || PropertyName == GET_MEMBER_NAME_CHECKED(USandboxItemData, PlacementProxy))
+    {
+        RefreshPlacementData(true);
+    }
+}
+#endif
+
+bool USandboxItemData::RefreshPlacementData(bool bLoadMesh)
+{
+    UStaticMesh* Mesh = bLoadMesh ? GhostMesh.LoadSynchronous() : GhostMesh.Get();
+    if (!Mesh)
+    {
+        // Keep what was cooked if the mesh is just not loaded yet
+        if (GhostMesh.IsNull())
+        {
+            LocalBounds = FBox(ForceInit);
+            PlacementShape = FSandboxPlacementShape();
+        }
+        return false;
+    }
+
+    LocalBounds = Mesh->GetBoundingBox();
+    PlacementShape = (PlacementProxy == ESandboxPlacementProxy::BoundsSphere)
+        ? FSandboxPlacementShape::MakeSphere(LocalBounds)
+        : FSandboxPlacementShape::MakeBox(LocalBounds);
+
+    if (PlacementProxy != ESandboxPlacementProxy::SimpleCollision) return true;
+
+    // A single simple primitive is a closer fit than the bounds, anything more complex keeps the bounds box
+    const UBodySetup* BodySetup = Mesh->GetBodySetup();
+    if (!BodySetup || BodySetup->AggGeom.GetElementCount() != 1) return true;
+
+    const FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+    if (AggGeom.BoxElems.Num() == 1)
+    {
+        const FKBoxElem& Box = AggGeom.BoxElems[0];
+        PlacementShape.Type = ESandboxPlacementShapeType::Box;
+        PlacementShape.Center = Box.Center;
+        PlacementShape.Rotation = Box.Rotation.Quaternion();
+        PlacementShape.Extent = FVector(Box.X, Box.Y, Box.Z) * 0.5f;
+    }
+    else if (AggGeom.SphereElems.Num() == 1)
+    {
+        const FKSphereElem& Sphere = AggGeom.SphereElems[0];
+        PlacementShape.Type = ESandboxPlacementShapeType::Sphere;
+        PlacementShape.Center = Sphere.Center;
+        PlacementShape.Rotation = FQuat::Identity;
+        PlacementShape.Extent = FVector(Sphere.Radius, 0.0f, 0.0f);
+    }
+    else if (AggGeom.SphylElems.Num() == 1)
+    {
+        const FKSphylElem& Capsule = AggGeom.SphylElems[0];
+        PlacementShape.Type = ESandboxPlacementShapeType::Capsule;
+        PlacementShape.Center = Capsule.Center;
+        PlacementShape.Rotation = Capsule.Rotation.Quaternion();
+        PlacementShape.Extent = FVector(Capsule.Radius, 0.0f, Capsule.Length * 0.5f + Capsule.Radius);
+    }
+
+    return true;
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "SandboxItemRegistry.h"
+#include "SandboxIdentityComponent.h"
+#include "Engine/World.h"
+
+USandboxItemRegistry* USandboxItemRegistry::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<USandboxItemRegistry>() : nullptr;
+}
+
+bool USandboxItemRegistry::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USandboxItemRegistry::RegisterItem(USandboxIdentityComponent* Identity)
+{
+    if (!Identity || Identity->RegistryIndex != INDEX_NONE) return;
+
+    Identity->RegistryIndex = Items.Add(Identity);
+
+    // Newly placed items have never been saved
+    MarkDirty(Identity);
+}
+
+void USandboxItemRegistry::UnregisterItem(USandboxIdentityComponent* Identity)
+{
+    if (!Identity || !Items.IsValidIndex(Identity->RegistryIndex) || Items[Identity->RegistryIndex] != Identity) return;
+
+    // Swap-remove keeps the array dense, patch the index of the moved entry
+    const int32 RemovedIndex = Identity->RegistryIndex;
+    Items.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+    if (Items.IsValidIndex(RemovedIndex) && Items[RemovedIndex])
+    {
+        Items[RemovedIndex]->RegistryIndex = RemovedIndex;
+    }
+
+    Identity->RegistryIndex = INDEX_NONE;
+}
+
+TArray<USandboxIdentityComponent*> USandboxItemRegistry::GetAllItems() const
+{
+    return TArray<USandboxIdentityComponent*>(Items);
+}
+
+void USandboxItemRegistry::MarkDirty(USandboxIdentityComponent* Identity)
+{
+    // Pooled (unregistered) items are not part of the world
+    if (!Identity || Identity->bSaveDirty || Identity->RegistryIndex == INDEX_NONE) return;
+
+    Identity->bSaveDirty = true;
+    DirtyItems.Add(Identity);
+}
+
+void USandboxItemRegistry::ClearDirty(USandboxIdentityComponent* Identity)
+{
+    // The entry stays in DirtyItems, ConsumeChanges skips it
+    if (Identity)
+    {
+        Identity->bSaveDirty = false;
+    }
+}
+
+void USandboxItemRegistry::NotifyItemDestroyed(USandboxIdentityComponent* Identity)
+{
+    if (Identity && Identity->ItemId != 0)
+    {
+        RemovedItemIds.Add(Identity->ItemId);
+    }
+}
+
+void USandboxItemRegistry::ConsumeChanges(TArray<USandboxIdentityComponent*>& OutDirtyItems, TArray<int32>& OutRemovedItemIds)
+{
+    OutDirtyItems.Reset(DirtyItems.Num());
+    for (USandboxIdentityComponent* Identity : DirtyItems)
+    {
+        // Entries cleared with ClearDirty are skipped
+        if (IsValid(Identity) && Identity->bSaveDirty)
+        {
+            Identity->bSaveDirty = false;
+            if (Identity->RegistryIndex != INDEX_NONE)
+            {
+                OutDirtyItems.Add(Identity);
+            }
+        }
+    }
+
+    OutRemovedItemIds = MoveTemp(RemovedItemIds);
+
+    DirtyItems.Reset();
+    RemovedItemIds.Reset();
+}
+
+void USandboxItemRegistry::ClearChanges()
+{
+    for (USandboxIdentityComponent* Identity : DirtyItems)
+    {
+        if (Identity)
+        {
+            Identity->bSaveDirty = false;
+        }
+    }
+
+    DirtyItems.Reset();
+    RemovedItemIds.Reset();
+}
\ No newline at end of file
@@ -0,0 +1,269 @@
+#include "SandboxPhysicsSleepSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+USandboxPhysicsSleepSubsystem* USandboxPhysicsSleepSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<USandboxPhysicsSleepSubsystem>() : nullptr;
+}
+
+bool USandboxPhysicsSleepSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USandboxPhysicsSleepSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USandboxPhysicsSleepSubsystem, STATGROUP_Tickables);
+}
+
+void USandboxPhysicsSleepSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (Bodies.Num() == 0) return;
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    const float LinearThresholdSq = FMath::Square(LinearVelocityThreshold);
+    const float AngularThresholdSq = FMath::Square(AngularVelocityThreshold);
+
+    // OPTIMIZATION: Round-robin slice, a body's still time accumulates across the frames it was skipped
+    int32 Checks = FMath::Min(MaxBodiesCheckedPerFrame, Bodies.Num());
+    while (Checks-- > 0 && Bodies.Num() > 0)
+    {
+        if (CheckCursor >= Bodies.Num())
+        {
+            CheckCursor = 0;
+        }
+
+        FWatchedBody& Body = Bodies[CheckCursor];
+        UPrimitiveComponent* Component = Body.Component.Get();
+
+        // Gone, or no longer simulating for reasons of its own (pooled, welded, disabled by gameplay)
+        if (!Component || (!Body.bFrozen && !Component->IsSimulatingPhysics()))
+        {
+            const FBox SupportBounds = Body.Bounds;
+            RemoveBodyAt(CheckCursor);
+            WakeBodiesAbove(SupportBounds);
+            continue;
+        }
+
+        const float Elapsed = (float)(Now - Body.LastCheckTime);
+        Body.LastCheckTime = Now;
+
+        if (Body.bFrozen)
+        {
+            // Sleeping bodies can be woken by the solver itself (contacts, impulses)
+            if (FreezeMode == ESandboxFreezeMode::Sleep && Component->IsSimulatingPhysics() && Component->RigidBodyIsAwake())
+            {
+                Body.bFrozen = false;
+                Body.StillTime = 0.0f;
+                FrozenBodyCount--;
+                TotalUnfreezes++;
+            }
+            CheckCursor++;
+            continue;
+        }
+
+        Body.Bounds = Component->Bounds.GetBox();
+
+        const bool bStill = Component->GetPhysicsLinearVelocity().SizeSquared() <= LinearThresholdSq
+            && Component->GetPhysicsAngularVelocityInDegrees().SizeSquared() <= AngularThresholdSq;
+
+        Body.StillTime = bStill ? Body.StillTime + Elapsed : 0.0f;
+        if (Body.StillTime >= SettleTime)
+        {
+            Freeze(Body, Component);
+        }
+
+        CheckCursor++;
+    }
+}
+
+void USandboxPhysicsSleepSubsystem::WatchActor(AActor* Actor)
+{
+    if (!IsValid(Actor)) return;
+
+    TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+    for (UPrimitiveComponent* Primitive : Primitives)
+    {
+        if (Primitive->IsSimulatingPhysics())
+        {
+            WatchComponent(Primitive);
+        }
+    }
+}
+
+void USandboxPhysicsSleepSubsystem::WatchComponent(UPrimitiveComponent* Component)
+{
+    if (!IsValid(Component)) return;
+
+    // Already watched: just restart the settle timer
+    if (const int32* FoundIndex = BodyIndexByComponent.Find(Component))
+    {
+        FWatchedBody& Body = Bodies[*FoundIndex];
+        if (Body.bFrozen)
+        {
+            Unfreeze(Body, Component);
+        }
+        Body.StillTime = 0.0f;
+        return;
+    }
+
+    if (!Component->IsSimulatingPhysics()) return;
+
+    FWatchedBody& Body = Bodies.AddDefaulted_GetRef();
+    Body.Component = Component;
+    Body.Bounds = Component->Bounds.GetBox();
+    Body.LastCheckTime = GetWorld()->GetTimeSeconds();
+    BodyIndexByComponent.Add(Component, Bodies.Num() - 1);
+}
+
+void USandboxPhysicsSleepSubsystem::UnfreezeActor(AActor* Actor)
+{
+    if (!IsValid(Actor)) return;
+
+    TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+    for (UPrimitiveComponent* Primitive : Primitives)
+    {
+        UnfreezeComponent(Primitive);
+    }
+}
+
+void USandboxPhysicsSleepSubsystem::UnfreezeComponent(UPrimitiveComponent* Component)
+{
+    const int32* FoundIndex = Component ? BodyIndexByComponent.Find(Component) : nullptr;
+    if (!FoundIndex) return;
+
+    FWatchedBody& Body = Bodies[*FoundIndex];
+    if (Body.bFrozen)
+    {
+        Unfreeze(Body, Component);
+    }
+    Body.StillTime = 0.0f;
+
+    // Grabbed or knocked away, whatever rests on it has to be able to fall
+    WakeBodiesAbove(Component->Bounds.GetBox());
+}
+
+void USandboxPhysicsSleepSubsystem::ForgetActor(AActor* Actor)
+{
+    if (!Actor || Bodies.Num() == 0) return;
+
+    TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+    for (UPrimitiveComponent* Primitive : Primitives)
+    {
+        if (const int32* FoundIndex = BodyIndexByComponent.Find(Primitive))
+        {
+            const int32 Index = *FoundIndex;
+            if (Bodies[Index].bFrozen)
+            {
+                Unfreeze(Bodies[Index], Primitive);
+            }
+            const FBox SupportBounds = Bodies[Index].Bounds;
+            RemoveBodyAt(Index);
+
+            // Pooled or promoted, its bodies stop supporting anything
+            WakeBodiesAbove(SupportBounds);
+        }
+    }
+}
+
+bool USandboxPhysicsSleepSubsystem::IsFrozen(const UPrimitiveComponent* Component) const
+{
+    const int32* FoundIndex = BodyIndexByComponent.Find(Component);
+    return FoundIndex && Bodies[*FoundIndex].bFrozen;
+}
+
+void USandboxPhysicsSleepSubsystem::Freeze(FWatchedBody& Body, UPrimitiveComponent* Component)
+{
+    if (FreezeMode == ESandboxFreezeMode::Kinematic)
+    {
+        // Out of the solver entirely; contact from simulating bodies brings it back
+        Body.bHadHitNotify = Component->BodyInstance.bNotifyRigidBodyCollision;
+        Component->SetSimulatePhysics(false);
+        Component->SetNotifyRigidBodyCollision(true);
+        Component->OnComponentHit.AddUniqueDynamic(this, &USandboxPhysicsSleepSubsystem::OnFrozenBodyHit);
+    }
+    else
+    {
+        Component->PutAllRigidBodiesToSleep();
+    }
+
+    Body.bFrozen = true;
+    FrozenBodyCount++;
+    TotalFreezes++;
+}
+
+void USandboxPhysicsSleepSubsystem::Unfreeze(FWatchedBody& Body, UPrimitiveComponent* Component)
+{
+    // A sleep freeze may have been made while the mode was different, restore by the body's actual state
+    if (!Component->IsSimulatingPhysics())
+    {
+        Component->OnComponentHit.RemoveDynamic(this, &USandboxPhysicsSleepSubsystem::OnFrozenBodyHit);
+        Component->SetNotifyRigidBodyCollision(Body.bHadHitNotify);
+        Component->SetSimulatePhysics(true);
+    }
+    Component->WakeAllRigidBodies();
+
+    Body.bFrozen = false;
+    Body.StillTime = 0.0f;
+    Body.LastCheckTime = GetWorld()->GetTimeSeconds();
+    FrozenBodyCount--;
+    TotalUnfreezes++;
+}
+
+void USandboxPhysicsSleepSubsystem::RemoveBodyAt(int32 Index)
+{
+    if (Bodies[Index].bFrozen)
+    {
+        FrozenBodyCount--;
+    }
+
+    BodyIndexByComponent.Remove(Bodies[Index].Component);
+    Bodies.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    if (Bodies.IsValidIndex(Index))
+    {
+        BodyIndexByComponent.Add(Bodies[Index].Component, Index);
+    }
+}
+
+void USandboxPhysicsSleepSubsystem::WakeBodiesAbove(const FBox& SupportBounds)
+{
+    if (FrozenBodyCount == 0 || !SupportBounds.IsValid) return;
+
+    TArray<FBox, TInlineAllocator<8>> Supports;
+    Supports.Add(SupportBounds);
+
+    while (Supports.Num() > 0 && FrozenBodyCount > 0)
+    {
+        const FBox Support = Supports.Pop(EAllowShrinking::No);
+
+        // Grown sideways and upwards only, bodies the support rests on are unaffected
+        const FBox WakeBox(Support.Min - FVector(SupportWakeMargin, SupportWakeMargin, 0.0f), Support.Max + FVector(SupportWakeMargin));
+
+        for (FWatchedBody& Body : Bodies)
+        {
+            if (!Body.bFrozen || Body.Bounds.Min.Z < Support.Min.Z || !WakeBox.Intersect(Body.Bounds)) continue;
+
+            UPrimitiveComponent* Component = Body.Component.Get();
+            if (!Component) continue;
+
+            Unfreeze(Body, Component);
+
+            // Once it moves, whatever rests on it loses its support as well
+            Supports.Add(Body.Bounds);
+        }
+    }
+}
+
+void USandboxPhysicsSleepSubsystem::OnFrozenBodyHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+    // Only moving bodies wake the item, resting neighbours touching it do not
+    if (OtherComp && OtherComp->IsSimulatingPhysics() && OtherComp->RigidBodyIsAwake())
+    {
+        UnfreezeComponent(HitComponent);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "SandboxPlacementQuerySubsystem.h"
+#include "SandboxItemRegistry.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+
+USandboxPlacementQuerySubsystem* USandboxPlacementQuerySubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<USandboxPlacementQuerySubsystem>() : nullptr;
+}
+
+bool USandboxPlacementQuerySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// =========================================================================
+// LINE TRACES
+// =========================================================================
+
+bool USandboxPlacementQuerySubsystem::RequestLineTrace(const UObject* Requester, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params, FHitResult& OutHit, bool& bOutHit)
+{
+    const TObjectKey<UObject> RequesterKey(Requester);
+    FRequesterTrace* Trace = RequesterTraces.Find(RequesterKey);
+    if (!Trace)
+    {
+        PruneRequesters(RequesterTraces);
+        Trace = &RequesterTraces.Add(RequesterKey);
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    const float ReuseDistanceSq = FMath::Square(TraceReuseDistance);
+    const bool bSameRay = Trace->bHasResult
+        && FVector::DistSquared(Trace->Start, Start) <= ReuseDistanceSq
+        && FVector::DistSquared(Trace->End, End) <= ReuseDistanceSq
+        && Now - Trace->Time <= CacheLifetime;
+
+    // OPTIMIZATION: One trace in flight per requester, a still camera issues none at all
+    if (!bSameRay && !Trace->bPending)
+    {
+        FTraceDelegate Delegate = FTraceDelegate::CreateUObject(this, &USandboxPlacementQuerySubsystem::OnLineTraceDone, RequesterKey);
+        GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, Channel, Params, FCollisionResponseParams::DefaultResponseParam, &Delegate);
+
+        Trace->Start = Start;
+        Trace->End = End;
+        Trace->bPending = true;
+        AsyncQueriesIssued++;
+    }
+
+    if (!Trace->bHasResult) return false;
+
+    OutHit = Trace->Hit;
+    bOutHit = Trace->bHit;
+    return true;
+}
+
+void USandboxPlacementQuerySubsystem::OnLineTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, TObjectKey<UObject> Requester)
+{
+    FRequesterTrace* Trace = RequesterTraces.Find(Requester);
+    if (!Trace) return;
+
+    // Keep the ray that was actually traced, the requester may have moved on since
+    Trace->Start = Datum.Start;
+    Trace->End = Datum.End;
+    Trace->bHit = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit;
+    Trace->Hit = Trace->bHit ? Datum.OutHits[0] : FHitResult();
+    Trace->Time = GetWorld()->GetTimeSeconds();
+    Trace->bHasResult = true;
+    Trace->bPending = false;
+}
+
+// =========================================================================
+// PLACEMENT OVERLAPS
+// =========================================================================
+
+bool USandboxPlacementQuerySubsystem::RequestPlacementOverlap(const UObject* Requester, const FVector& Location, const FQuat& Rotation, const UStaticMesh* Mesh, const AActor* IgnoredActor, const FVector& BoxCenter, const FVector& BoxExtent, const FCollisionQueryParams& Params, bool& bOutBlocked)
+{
+    ValidateCache();
+
+    const TObjectKey<UObject> RequesterKey(Requester);
+    FRequesterPlacement* Placement = RequesterPlacements.Find(RequesterKey);
+    if (!Placement)
+    {
+        PruneRequesters(RequesterPlacements);
+        Placement = &RequesterPlacements.Add(RequesterKey);
+    }
+
+    const FPlacementKey Key = MakeKey(Location, Rotation, Mesh, IgnoredActor);
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    FCachedPlacement& Cached = PlacementCache.FindOrAdd(Key);
+    const bool bHasCachedResult = Cached.bHasResult;
+    if (bHasCachedResult && Now - Cached.Time <= CacheLifetime)
+    {
+        CacheHits++;
+        Placement->bBlocked = Cached.bBlocked;
+        Placement->bHasResult = true;
+    }
+    else if (!Cached.bPending)
+    {
+        FOverlapDelegate Delegate = FOverlapDelegate::CreateUObject(this, &USandboxPlacementQuerySubsystem::OnOverlapDone, Key, RequesterKey);
+        GetWorld()->AsyncOverlapByChannel(BoxCenter, Rotation, ECC_Visibility, FCollisionShape::MakeBox(BoxExtent), Params, FCollisionResponseParams::DefaultResponseParam, &Delegate);
+
+        Cached.bPending = true;
+        AsyncQueriesIssued++;
+    }
+
+    // An expired entry is still a better answer than the previous position's
+    if (bHasCachedResult)
+    {
+        Placement->bBlocked = Cached.bBlocked;
+        Placement->bHasResult = true;
+    }
+
+    if (!Placement->bHasResult) return false;
+
+    bOutBlocked = Placement->bBlocked;
+    return true;
+}
+
+void USandboxPlacementQuerySubsystem::OnOverlapDone(const FTraceHandle& Handle, FOverlapDatum& Datum, FPlacementKey Key, TObjectKey<UObject> Requester)
+{
+    bool bBlocked = false;
+    for (const FOverlapResult& Overlap : Datum.OutOverlaps)
+    {
+        if (Overlap.bBlockingHit)
+        {
+            bBlocked = true;
+            break;
+        }
+    }
+
+    // The cache may have been flushed while the query was in flight, the result is still current
+    FCachedPlacement& Cached = PlacementCache.FindOrAdd(Key);
+    Cached.bBlocked = bBlocked;
+    Cached.Time = GetWorld()->GetTimeSeconds();
+    Cached.bHasResult = true;
+    Cached.bPending = false;
+
+    if (FRequesterPlacement* Placement = RequesterPlacements.Find(Requester))
+    {
+        Placement->bBlocked = bBlocked;
+        Placement->bHasResult = true;
+    }
+}
+
+void USandboxPlacementQuerySubsystem::StorePlacementResult(const UObject* Requester, const FVector& Location, const FQuat& Rotation, const UStaticMesh* Mesh, const AActor* IgnoredActor, bool bBlocked)
+{
+    ValidateCache();
+
+    FCachedPlacement& Cached = PlacementCache.FindOrAdd(MakeKey(Location, Rotation, Mesh, IgnoredActor));
+    Cached.bBlocked = bBlocked;
+    Cached.Time = GetWorld()->GetTimeSeconds();
+    Cached.bHasResult = true;
+
+    FRequesterPlacement& Placement = RequesterPlacements.FindOrAdd(TObjectKey<UObject>(Requester));
+    Placement.bBlocked = bBlocked;
+    Placement.bHasResult = true;
+}
+
+void USandboxPlacementQuerySubsystem::InvalidateCache()
+{
+    // In-flight queries re-add their entry when they complete
+    PlacementCache.Reset();
+}
+
+USandboxPlacementQuerySubsystem::FPlacementKey USandboxPlacementQuerySubsystem::MakeKey(const FVector& Location, const FQuat& Rotation, const UStaticMesh* Mesh, const AActor* IgnoredActor) const
+{
+    const FRotator Rotator = Rotation.Rotator();
+
+    FPlacementKey Key;
+    Key.Cell = FIntVector(
+        FMath::RoundToInt(Location.X / CacheCellSize),
+        FMath::RoundToInt(Location.Y / CacheCellSize),
+        FMath::RoundToInt(Location.Z / CacheCellSize));
+    Key.Pitch = FRotator::CompressAxisToShort(Rotator.Pitch);
+    Key.Yaw = FRotator::CompressAxisToShort(Rotator.Yaw);
+    Key.Roll = FRotator::CompressAxisToShort(Rotator.Roll);
+    Key.Mesh = Mesh;
+    Key.IgnoredActor = IgnoredActor;
+    return Key;
+}
+
+void USandboxPlacementQuerySubsystem::ValidateCache()
+{
+    // Placing or removing an item changes what overlaps where
+    const USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this);
+    const int32 ItemCount = Registry ? Registry->GetItemCount() : 0;
+    if (ItemCount != CachedItemCount)
+    {
+        InvalidateCache();
+        CachedItemCount = ItemCount;
+    }
+    else if (PlacementCache.Num() >= MaxCachedPlacements)
+    {
+        InvalidateCache();
+    }
+}
+
+template <typename ValueType>
+void USandboxPlacementQuerySubsystem::PruneRequesters(TMap<TObjectKey<UObject>, ValueType>& Requesters)
+{
+    for (auto It = Requesters.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
\ No newline at end of file
@@ -1 +1,715 @@
-#include "SandboxSaveGame.h"
\ No newline at end of file
+#include "SandboxSaveGame.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/Compression.h"
+
+// =========================================================================
+// TRANSFORM CODEC
+// =========================================================================
+
+namespace SandboxTransformCodec
+{
+    // 1: raw item stream
+    // 2: item stream wrapped in Oodle compression
+    // 3: compressed item stream with stable item ids
+    // 4: raw item stream with stable item ids (compression fallback)
+    constexpr uint8 CodecVersion = 3;
+    constexpr uint8 UncompressedCodecVersion = 4;
+
+    bool IsCompressed(uint8 Version)
+    {
+        return Version == 2 || Version == 3;
+    }
+
+    bool HasItemIds(uint8 Version)
+    {
+        return Version >= 3;
+    }
+
+    enum EItemFlags : uint8
+    {
+        FullPrecision = 1 << 0,
+        HasScale      = 1 << 1,
+        YawOnly       = 1 << 2,
+        Asleep        = 1 << 3,
+        HasVelocity   = 1 << 4
+    };
+
+    // Physics flags are self-describing, older blobs simply never set them
+    uint8 GetPhysicsFlags(const FSavedPhysicsState& Physics)
+    {
+        uint8 Flags = Physics.bAsleep ? Asleep : 0;
+        if (!Physics.bAsleep && Physics.HasVelocity())
+        {
+            Flags |= HasVelocity;
+        }
+        return Flags;
+    }
+
+    void SerializePhysics(FArchive& Ar, FSavedPhysicsState& Physics, uint8 Flags)
+    {
+        Physics.bAsleep = (Flags & Asleep) != 0;
+        if (Flags & HasVelocity)
+        {
+            Ar << Physics.LinearVelocity;
+            Ar << Physics.AngularVelocity;
+        }
+    }
+
+    // Smallest-three: 2 bit index of the dropped component + 3 x 15 bit components = 47 bits
+    constexpr int32 ComponentBits = 15;
+    constexpr uint32 ComponentMax = (1u << ComponentBits) - 1;
+    constexpr double ComponentRange = UE_DOUBLE_INV_SQRT_2;
+
+    constexpr double YawScale = 65536.0 / 360.0;
+
+    uint32 ZigZag(int32 Value)
+    {
+        return (uint32(Value) << 1) ^ uint32(Value >> 31);
+    }
+
+    int32 UnZigZag(uint32 Value)
+    {
+        return int32(Value >> 1) ^ -int32(Value & 1);
+    }
+
+    uint64 PackQuat(FQuat Q)
+    {
+        Q.Normalize();
+
+        const double Components[4] = { Q.X, Q.Y, Q.Z, Q.W };
+        int32 LargestIndex = 0;
+        for (int32 i = 1; i < 4; i++)
+        {
+            if (FMath::Abs(Components[i]) > FMath::Abs(Components[LargestIndex]))
+            {
+                LargestIndex = i;
+            }
+        }
+
+        // q and -q are the same rotation, keep the dropped component positive
+        const double Sign = Components[LargestIndex] < 0.0 ? -1.0 : 1.0;
+
+        uint64 Bits = uint64(LargestIndex);
+        int32 Shift = 2;
+        for (int32 i = 0; i < 4; i++)
+        {
+            if (i == LargestIndex) continue;
+
+            const double Normalized = (Components[i] * Sign / ComponentRange + 1.0) * 0.5;
+            const uint32 Quantized = (uint32)FMath::Clamp<int64>(FMath::RoundToInt64(Normalized * ComponentMax), 0, ComponentMax);
+            Bits |= uint64(Quantized) << Shift;
+            Shift += ComponentBits;
+        }
+        return Bits;
+    }
+
+    FQuat UnpackQuat(uint64 Bits)
+    {
+        const int32 LargestIndex = int32(Bits & 0x3);
+
+        double Components[4];
+        double SumSquares = 0.0;
+        int32 Shift = 2;
+        for (int32 i = 0; i < 4; i++)
+        {
+            if (i == LargestIndex) continue;
+
+            const uint32 Quantized = uint32(Bits >> Shift) & ComponentMax;
+            Components[i] = ((double)Quantized / ComponentMax * 2.0 - 1.0) * ComponentRange;
+            SumSquares += Components[i] * Components[i];
+            Shift += ComponentBits;
+        }
+        Components[LargestIndex] = FMath::Sqrt(FMath::Max(0.0, 1.0 - SumSquares));
+
+        return FQuat(Components[0], Components[1], Components[2], Components[3]);
+    }
+
+    void SerializeQuatBits(FArchive& Ar, uint64& Bits)
+    {
+        // 47 significant bits fit in 6 bytes
+        for (int32 Byte = 0; Byte < 6; Byte++)
+        {
+            uint8 Value = uint8(Bits >> (Byte * 8));
+            Ar << Value;
+            if (Ar.IsLoading())
+            {
+                Bits |= uint64(Value) << (Byte * 8);
+            }
+        }
+    }
+
+    bool IsYawOnly(const FQuat& Q)
+    {
+        return FMath::IsNearlyZero(Q.X, UE_KINDA_SMALL_NUMBER) && FMath::IsNearlyZero(Q.Y, UE_KINDA_SMALL_NUMBER);
+    }
+
+    double DecodeYawDegrees(uint16 Yaw)
+    {
+        return (double)Yaw / YawScale;
+    }
+
+    uint16 EncodeYawDegrees(double YawDegrees)
+    {
+        return uint16(FMath::RoundToInt64(FRotator::ClampAxis(YawDegrees) * YawScale) & 0xFFFF);
+    }
+
+    /** Quantizes a transform. Returns false if it cannot be represented within the error bounds. */
+    bool Quantize(const FTransform& Transform, const FVector& Origin, const FSandboxTransformQuantization& Settings,
+        FIntVector& OutPosition, uint8& OutFlags, uint64& OutRotation)
+    {
+        const double Step = Settings.PositionStep;
+        const FVector Relative = (Transform.GetLocation() - Origin) / Step;
+        if (Relative.GetAbsMax() >= (double)MAX_int32) return false;
+
+        OutPosition = FIntVector(
+            (int32)FMath::RoundToInt64(Relative.X),
+            (int32)FMath::RoundToInt64(Relative.Y),
+            (int32)FMath::RoundToInt64(Relative.Z)
+        );
+
+        const FVector DecodedPosition = Origin + FVector(OutPosition) * Step;
+        if ((DecodedPosition - Transform.GetLocation()).GetAbsMax() > Settings.MaxPositionError) return false;
+
+        const FQuat Rotation = Transform.GetRotation().GetNormalized();
+        FQuat DecodedRotation;
+        if (IsYawOnly(Rotation))
+        {
+            OutFlags |= YawOnly;
+            const double YawDegrees = FMath::RadiansToDegrees(2.0 * FMath::Atan2(Rotation.Z, Rotation.W));
+            OutRotation = EncodeYawDegrees(YawDegrees);
+            DecodedRotation = FQuat(FVector::UpVector, FMath::DegreesToRadians(DecodeYawDegrees((uint16)OutRotation)));
+        }
+        else
+        {
+            OutRotation = PackQuat(Rotation);
+            DecodedRotation = UnpackQuat(OutRotation);
+        }
+
+        if (FMath::RadiansToDegrees(Rotation.AngularDistance(DecodedRotation)) > Settings.MaxRotationErrorDegrees) return false;
+
+        if (!Transform.GetScale3D().Equals(FVector::OneVector, UE_KINDA_SMALL_NUMBER))
+        {
+            OutFlags |= HasScale;
+        }
+        return true;
+    }
+
+    void WriteItem(FArchive& Ar, const FSavedItemCompact& Item, const FVector& Origin, const FSandboxTransformQuantization& Settings)
+    {
+        uint32 PackedPalette = uint32(Item.PaletteIndex + 1);
+        Ar.SerializeIntPacked(PackedPalette);
+
+        uint32 PackedId = uint32(Item.ItemId);
+        Ar.SerializeIntPacked(PackedId);
+
+        uint8 Flags = 0;
+        FIntVector Position;
+        uint64 Rotation = 0;
+        FSavedPhysicsState Physics = Item.Physics;
+        const bool bQuantize = Settings.Encoding == ESandboxTransformEncoding::Quantized;
+        if (!bQuantize || !Quantize(Item.Transform, Origin, Settings, Position, Flags, Rotation))
+        {
+            // Full encoding, or the error bound was exceeded: keep this item at full precision
+            Flags = FullPrecision | GetPhysicsFlags(Physics);
+            Ar << Flags;
+            FTransform Transform = Item.Transform;
+            Ar << Transform;
+            SerializePhysics(Ar, Physics, Flags);
+            return;
+        }
+
+        Flags |= GetPhysicsFlags(Physics);
+        Ar << Flags;
+
+        for (int32 Axis = 0; Axis < 3; Axis++)
+        {
+            uint32 Encoded = ZigZag(Position[Axis]);
+            Ar.SerializeIntPacked(Encoded);
+        }
+
+        if (Flags & YawOnly)
+        {
+            uint16 Yaw = (uint16)Rotation;
+            Ar << Yaw;
+        }
+        else
+        {
+            SerializeQuatBits(Ar, Rotation);
+        }
+
+        if (Flags & HasScale)
+        {
+            FVector3f Scale(Item.Transform.GetScale3D());
+            Ar << Scale;
+        }
+
+        SerializePhysics(Ar, Physics, Flags);
+    }
+
+    void ReadItem(FArchive& Ar, FSavedItemCompact& Item, const FVector& Origin, double Step, bool bHasItemIds)
+    {
+        uint32 PackedPalette = 0;
+        Ar.SerializeIntPacked(PackedPalette);
+        Item.PaletteIndex = int32(PackedPalette) - 1;
+
+        if (bHasItemIds)
+        {
+            uint32 PackedId = 0;
+            Ar.SerializeIntPacked(PackedId);
+            Item.ItemId = int32(PackedId);
+        }
+
+        uint8 Flags = 0;
+        Ar << Flags;
+
+        if (Flags & FullPrecision)
+        {
+            Ar << Item.Transform;
+            SerializePhysics(Ar, Item.Physics, Flags);
+            return;
+        }
+
+        FIntVector Position;
+        for (int32 Axis = 0; Axis < 3; Axis++)
+        {
+            uint32 Encoded = 0;
+            Ar.SerializeIntPacked(Encoded);
+            Position[Axis] = UnZigZag(Encoded);
+        }
+        Item.Transform.SetLocation(Origin + FVector(Position) * Step);
+
+        if (Flags & YawOnly)
+        {
+            uint16 Yaw = 0;
+            Ar << Yaw;
+            Item.Transform.SetRotation(FQuat(FVector::UpVector, FMath::DegreesToRadians(DecodeYawDegrees(Yaw))));
+        }
+        else
+        {
+            uint64 Rotation = 0;
+            SerializeQuatBits(Ar, Rotation);
+            Item.Transform.SetRotation(UnpackQuat(Rotation));
+        }
+
+        FVector3f Scale = FVector3f::OneVector;
+        if (Flags & HasScale)
+        {
+            Ar << Scale;
+        }
+        Item.Transform.SetScale3D(FVector(Scale));
+
+        SerializePhysics(Ar, Item.Physics, Flags);
+    }
+}
+
+void USandboxSaveGame::PackLevel(FSavedLevelData& Level, const FSandboxTransformQuantization& Settings)
+{
+    Level.PackedItems.Reset();
+
+    // Origin at the center of the level's items keeps fixed-point offsets small
+    FBox Bounds(ForceInit);
+    for (const FSavedItemCompact& Item : Level.Items)
+    {
+        Bounds += Item.Transform.GetLocation();
+    }
+
+    const double Step = FMath::Max(Settings.PositionStep, 0.001f);
+    FVector Origin = Bounds.IsValid ? Bounds.GetCenter() : FVector::ZeroVector;
+    Origin = FVector(FMath::GridSnap(Origin.X, Step), FMath::GridSnap(Origin.Y, Step), FMath::GridSnap(Origin.Z, Step));
+
+    FSandboxTransformQuantization EffectiveSettings = Settings;
+    EffectiveSettings.PositionStep = Step;
+
+    TArray<uint8> RawStream;
+    FMemoryWriter Writer(RawStream);
+
+    double SerializedStep = Step;
+    uint32 Count = Level.Items.Num();
+    Writer << Origin;
+    Writer << SerializedStep;
+    Writer.SerializeIntPacked(Count);
+
+    for (const FSavedItemCompact& Item : Level.Items)
+    {
+        SandboxTransformCodec::WriteItem(Writer, Item, Origin, EffectiveSettings);
+    }
+
+    // Header: codec version + raw size, followed by the compressed stream
+    int32 RawSize = RawStream.Num();
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, RawSize);
+
+    FMemoryWriter BlobWriter(Level.PackedItems);
+    uint8 Version = SandboxTransformCodec::CodecVersion;
+    BlobWriter << Version;
+    BlobWriter << RawSize;
+
+    const int32 HeaderSize = Level.PackedItems.Num();
+    Level.PackedItems.AddUninitialized(CompressedSize);
+
+    if (FCompression::CompressMemory(NAME_Oodle, Level.PackedItems.GetData() + HeaderSize, CompressedSize, RawStream.GetData(), RawSize))
+    {
+        Level.PackedItems.SetNum(HeaderSize + CompressedSize);
+    }
+    else
+    {
+        // Compression failed, store the raw stream instead
+        Level.PackedItems.Reset();
+        Version = SandboxTransformCodec::UncompressedCodecVersion;
+        Level.PackedItems.Add(Version);
+        Level.PackedItems.Append(RawStream);
+    }
+
+    Level.bPackedItemsValid = true;
+}
+
+bool USandboxSaveGame::UnpackLevel(FSavedLevelData& Level)
+{
+    Level.Items.Reset();
+    Level.InvalidateItemIndex();
+    if (Level.PackedItems.Num() == 0) return true;
+
+    uint8 Version = Level.PackedItems[0];
+
+    if (Version == 0 || Version > SandboxTransformCodec::UncompressedCodecVersion) return false;
+
+    TArray<uint8> RawStream;
+    if (SandboxTransformCodec::IsCompressed(Version))
+    {
+        FMemoryReader HeaderReader(Level.PackedItems);
+        HeaderReader.Seek(1);
+        int32 RawSize = 0;
+        HeaderReader << RawSize;
+
+        const int32 HeaderSize = (int32)HeaderReader.Tell();
+        if (HeaderReader.IsError() || RawSize < 0) return false;
+
+        RawStream.SetNumUninitialized(RawSize);
+        if (!FCompression::UncompressMemory(NAME_Oodle, RawStream.GetData(), RawSize, Level.PackedItems.GetData() + HeaderSize, Level.PackedItems.Num() - HeaderSize))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        RawStream.Append(Level.PackedItems.GetData() + 1, Level.PackedItems.Num() - 1);
+    }
+
+    FMemoryReader Reader(RawStream);
+
+    FVector Origin;
+    double Step = 1.0;
+    uint32 Count = 0;
+    Reader << Origin;
+    Reader << Step;
+    Reader.SerializeIntPacked(Count);
+
+    if (Reader.IsError()) return false;
+
+    Level.Items.SetNum(Count);
+    for (FSavedItemCompact& Item : Level.Items)
+    {
+        SandboxTransformCodec::ReadItem(Reader, Item, Origin, Step, SandboxTransformCodec::HasItemIds(Version));
+        if (Reader.IsError())
+        {
+            Level.Items.Reset();
+            return false;
+        }
+
+        Level.NextItemId = FMath::Max(Level.NextItemId, Item.ItemId + 1);
+    }
+
+    // Blob still matches Items, keep it so an unchanged level is not re-encoded on the next save
+    Level.bPackedItemsValid = true;
+    return true;
+}
+
+// =========================================================================
+// SERIALIZATION
+// =========================================================================
+
+void USandboxSaveGame::Serialize(FArchive& Ar)
+{
+    const bool bWritingToDisk = Ar.IsSaving() && Ar.IsPersistent();
+    const bool bReadingFromDisk = Ar.IsLoading() && Ar.IsPersistent();
+
+    // Only PackedItems goes to disk, for both encodings; Full packs every transform at full precision.
+    // OPTIMIZATION: Tagged serialization sees one byte blob per level instead of a struct per item
+    TArray<TArray<FSavedItemCompact>> StashedItems;
+    if (bWritingToDisk)
+    {
+        SaveVersion = ESandboxSaveVersion::Latest;
+
+        StashedItems.SetNum(Levels.Num());
+        for (int32 i = 0; i < Levels.Num(); i++)
+        {
+            FSavedLevelData& Level = Levels[i];
+
+            // Levels packed earlier (e.g. on a save worker) are not re-encoded
+            if (!Level.bPackedItemsValid)
+            {
+                PackLevel(Level, TransformQuantization);
+            }
+            StashedItems[i] = MoveTemp(Level.Items);
+        }
+    }
+
+    Super::Serialize(Ar);
+
+    if (bWritingToDisk)
+    {
+        for (int32 i = 0; i < Levels.Num(); i++)
+        {
+            // The same array comes back, its item index stays valid
+            Levels[i].Items = MoveTemp(StashedItems[i]);
+        }
+    }
+
+    if (bReadingFromDisk)
+    {
+        if (SaveVersion < ESandboxSaveVersion::PerLevelBlocks)
+        {
+            MigrateLegacyItems();
+        }
+
+        for (FSavedLevelData& Level : Levels)
+        {
+            if (Level.PackedItems.Num() > 0 && !UnpackLevel(Level))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("SandboxSaveGame: corrupt packed items for level %s"), *Level.LevelName);
+            }
+        }
+    }
+}
+
+FSavedLevelData* USandboxSaveGame::FindLevel(const FString& LevelName)
+{
+    return Levels.FindByPredicate([&LevelName](const FSavedLevelData& Level)
+        {
+            return Level.LevelName == LevelName;
+        });
+}
+
+const FSavedLevelData* USandboxSaveGame::FindLevel(const FString& LevelName) const
+{
+    return const_cast<USandboxSaveGame*>(this)->FindLevel(LevelName);
+}
+
+FSavedLevelData& USandboxSaveGame::FindOrAddLevel(const FString& LevelName)
+{
+    if (FSavedLevelData* Existing = FindLevel(LevelName))
+    {
+        return *Existing;
+    }
+
+    FSavedLevelData& NewLevel = Levels.AddDefaulted_GetRef();
+    NewLevel.LevelName = LevelName;
+    return NewLevel;
+}
+
+bool USandboxSaveGame::ApplyJournal(const USandboxSaveJournal& Journal)
+{
+    if (Journal.BaseRevision != SaveRevision) return false;
+
+    // Journal palette is a superset of the base palette it was recorded against
+    if (Journal.AssetPalette.Num() > AssetPalette.Num())
+    {
+        AssetPalette = Journal.AssetPalette;
+    }
+
+    for (const FSavedLevelJournal& LevelJournal : Journal.Levels)
+    {
+        FSavedLevelData& Level = FindOrAddLevel(LevelJournal.LevelName);
+
+        for (int32 RemovedId : LevelJournal.Removals)
+        {
+            Level.RemoveItem(RemovedId);
+        }
+
+        for (const FSavedItemCompact& Item : LevelJournal.Upserts)
+        {
+            Level.UpsertItem(Item);
+        }
+    }
+
+    return true;
+}
+
+void USandboxSaveGame::MigrateLegacyItems()
+{
+    if (Items.Num() == 0) return;
+
+    // Items of one level were usually written together, so cache the last block
+    FSavedLevelData* CurrentLevel = nullptr;
+    for (FSavedItemCompact& Item : Items)
+    {
+        if (!CurrentLevel || CurrentLevel->LevelName != Item.LevelName)
+        {
+            CurrentLevel = &FindOrAddLevel(Item.LevelName);
+        }
+
+        Item.LevelName.Empty();
+        CurrentLevel->Items.Add(MoveTemp(Item));
+        CurrentLevel->InvalidateItemIndex();
+    }
+
+    Items.Empty();
+    SaveVersion = ESandboxSaveVersion::Latest;
+}
+
+// =========================================================================
+// LEVEL ITEM INDEX
+// =========================================================================
+
+void FSavedLevelData::EnsureItemIndex()
+{
+    if (bItemIndexValid) return;
+
+    ItemIndexById.Reset();
+    ItemIndexById.Reserve(Items.Num());
+    for (int32 i = 0; i < Items.Num(); i++)
+    {
+        ItemIndexById.Add(Items[i].ItemId, i);
+    }
+    bItemIndexValid = true;
+}
+
+bool FSavedLevelData::AssignMissingItemIds()
+{
+    bool bAssigned = false;
+    for (FSavedItemCompact& Item : Items)
+    {
+        if (Item.ItemId == 0)
+        {
+            Item.ItemId = NextItemId++;
+            bAssigned = true;
+        }
+    }
+
+    if (bAssigned)
+    {
+        InvalidateItemIndex();
+        bPackedItemsValid = false;
+    }
+    return bAssigned;
+}
+
+void FSavedLevelData::UpsertItem(const FSavedItemCompact& Item)
+{
+    EnsureItemIndex();
+    bPackedItemsValid = false;
+    NextItemId = FMath::Max(NextItemId, Item.ItemId + 1);
+
+    if (int32* FoundIndex = ItemIndexById.Find(Item.ItemId))
+    {
+        Items[*FoundIndex] = Item;
+        return;
+    }
+
+    ItemIndexById.Add(Item.ItemId, Items.Add(Item));
+}
+
+void FSavedLevelData::RemoveItem(int32 ItemId)
+{
+    EnsureItemIndex();
+
+    int32 RemovedIndex = INDEX_NONE;
+    if (!ItemIndexById.RemoveAndCopyValue(ItemId, RemovedIndex)) return;
+
+    bPackedItemsValid = false;
+    Items.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+    if (Items.IsValidIndex(RemovedIndex))
+    {
+        ItemIndexById.Add(Items[RemovedIndex].ItemId, RemovedIndex);
+    }
+}
+
+const FSavedItemCompact* FSavedLevelData::FindItem(int32 ItemId)
+{
+    EnsureItemIndex();
+
+    const int32* FoundIndex = ItemIndexById.Find(ItemId);
+    return FoundIndex ? &Items[*FoundIndex] : nullptr;
+}
+
+// =========================================================================
+// JOURNAL
+// =========================================================================
+
+FSavedLevelJournal& USandboxSaveJournal::FindOrAddLevel(const FString& LevelName)
+{
+    if (FSavedLevelJournal* Existing = Levels.FindByPredicate([&LevelName](const FSavedLevelJournal& Level)
+        {
+            return Level.LevelName == LevelName;
+        }))
+    {
+        return *Existing;
+    }
+
+    FSavedLevelJournal& NewLevel = Levels.AddDefaulted_GetRef();
+    NewLevel.LevelName = LevelName;
+    return NewLevel;
+}
+
+void USandboxSaveJournal::EnsureUpsertIndex(FSavedLevelJournal& Level)
+{
+    if (Level.UpsertIndexById.Num() == Level.Upserts.Num()) return;
+
+    Level.UpsertIndexById.Reset();
+    for (int32 i = 0; i < Level.Upserts.Num(); i++)
+    {
+        Level.UpsertIndexById.Add(Level.Upserts[i].ItemId, i);
+    }
+}
+
+void USandboxSaveJournal::RecordUpsert(const FString& LevelName, const FSavedItemCompact& Item)
+{
+    FSavedLevelJournal& Level = FindOrAddLevel(LevelName);
+    EnsureUpsertIndex(Level);
+
+    // Only the latest state of an item matters
+    if (int32* FoundIndex = Level.UpsertIndexById.Find(Item.ItemId))
+    {
+        Level.Upserts[*FoundIndex] = Item;
+        return;
+    }
+
+    Level.UpsertIndexById.Add(Item.ItemId, Level.Upserts.Add(Item));
+}
+
+void USandboxSaveJournal::RecordRemoval(const FString& LevelName, int32 ItemId)
+{
+    FSavedLevelJournal& Level = FindOrAddLevel(LevelName);
+    EnsureUpsertIndex(Level);
+
+    // A pending upsert of a removed item is obsolete
+    int32 UpsertIndex = INDEX_NONE;
+    if (Level.UpsertIndexById.RemoveAndCopyValue(ItemId, UpsertIndex))
+    {
+        Level.Upserts.RemoveAtSwap(UpsertIndex, 1, EAllowShrinking::No);
+        if (Level.Upserts.IsValidIndex(UpsertIndex))
+        {
+            Level.UpsertIndexById.Add(Level.Upserts[UpsertIndex].ItemId, UpsertIndex);
+        }
+    }
+
+    // Ids are never reused, so each item is removed at most once
+    Level.Removals.Add(ItemId);
+}
+
+int32 USandboxSaveJournal::GetRecordCount() const
+{
+    int32 Count = 0;
+    for (const FSavedLevelJournal& Level : Levels)
+    {
+        Count += Level.Upserts.Num() + Level.Removals.Num();
+    }
+    return Count;
+}
+
+void USandboxSaveJournal::Reset(int32 NewBaseRevision)
+{
+    BaseRevision = NewBaseRevision;
+    AssetPalette.Reset();
+    Levels.Reset();
+}
\ No newline at end of file
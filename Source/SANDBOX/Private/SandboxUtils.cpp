@@ -1,4 +1,11 @@
 #include "SandboxUtils.h"
+#include "SandboxPlacementQuerySubsystem.h"
+#include "SandboxViewQuerySubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "SandboxItemData.h"
+#include "SandboxItemRegistry.h"
+#include "SandboxWorldManager.h"
+#include "Async/ParallelFor.h"
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
 #include "Components/StaticMeshComponent.h"
@@ -12,6 +19,158 @@
 // BUILDING & MATH
 // =========================================================================
 
+namespace SandboxPlacement
+{
+    /** Batches smaller than this are validated on the game thread. */
+    static constexpr int32 ParallelBatchThreshold = 16;
+
+    /** Shrink applied to placement shapes to avoid floor contact. */
+    static constexpr float PlacementShrinkFactor = 0.95f;
+
+    /** Snapped transform for a view-ray result, shared by the sync and async paths. */
+    static bool MakePlacementTransform(
+        bool bHit,
+        const FHitResult& HitResult,
+        const FVector& TraceStart,
+        const FVector& CameraForward,
+        float TraceDistance,
+        float GridSize,
+        bool bAlignToNormal,
+        float AdditionalYaw,
+        FTransform& OutTransform)
+    {
+        FQuat YawRotation(FVector::UpVector, FMath::DegreesToRadians(AdditionalYaw));
+
+        if (bHit)
+        {
+            FVector FinalLocation = HitResult.Location;
+            FQuat FinalRotation = FQuat::Identity;
+
+            if (GridSize > 0.0f)
+            {
+                FinalLocation.X = FMath::GridSnap(FinalLocation.X, GridSize);
+                FinalLocation.Y = FMath::GridSnap(FinalLocation.Y, GridSize);
+            }
+
+            if (bAlignToNormal)
+            {
+                FinalRotation = FRotationMatrix::MakeFromZ(HitResult.ImpactNormal).ToQuat();
+            }
+
+            FinalRotation = FinalRotation * YawRotation;
+
+            OutTransform.SetLocation(FinalLocation);
+            OutTransform.SetRotation(FinalRotation);
+            OutTransform.SetScale3D(FVector(1.0f));
+            return true;
+        }
+
+        // Sky Logic
+        FVector FloatingLocation = TraceStart + (CameraForward * (TraceDistance * 0.5f));
+        if (GridSize > 0.0f)
+        {
+            FloatingLocation.X = FMath::GridSnap(FloatingLocation.X, GridSize);
+            FloatingLocation.Y = FMath::GridSnap(FloatingLocation.Y, GridSize);
+            FloatingLocation.Z = FMath::GridSnap(FloatingLocation.Z, GridSize);
+        }
+
+        OutTransform.SetLocation(FloatingLocation);
+        OutTransform.SetRotation(YawRotation);
+        OutTransform.SetScale3D(FVector(1.0f));
+
+        return false;
+    }
+
+    /** World-space overlap box of the local bounds at the placement. */
+    static void GetPlacementBox(const FVector& Min, const FVector& Max, const FVector& ItemLocation, const FQuat& ItemRotation, FVector& OutCenter, FVector& OutExtent)
+    {
+        FVector LocalCenter = (Min + Max) * 0.5f;
+        OutExtent = (Max - Min) * 0.5f;
+        OutExtent *= PlacementShrinkFactor;
+
+        OutCenter = ItemLocation + ItemRotation.RotateVector(LocalCenter);
+    }
+
+    static void GetPlacementBox(UStaticMeshComponent* MeshComponent, const FVector& ItemLocation, const FQuat& ItemRotation, FVector& OutCenter, FVector& OutExtent)
+    {
+        FVector Min, Max;
+        MeshComponent->GetLocalBounds(Min, Max);
+        GetPlacementBox(Min, Max, ItemLocation, ItemRotation, OutCenter, OutExtent);
+    }
+
+    static FCollisionQueryParams MakePlacementQueryParams(AActor* IgnoredActor)
+    {
+        FCollisionQueryParams QueryParams;
+        QueryParams.AddIgnoredActor(IgnoredActor);
+        if (IgnoredActor && IgnoredActor->GetOwner())
+        {
+            QueryParams.AddIgnoredActor(IgnoredActor->GetOwner());
+        }
+        return QueryParams;
+    }
+
+    /** Thread-safe: reads only the shape and the scene. */
+    static bool IsShapeBlocked(const UWorld* World, const FSandboxPlacementShape& Shape, const FTransform& ItemTransform, const FCollisionQueryParams& QueryParams)
+    {
+        FVector WorldCenter;
+        FQuat WorldRotation;
+        Shape.GetWorldPose(ItemTransform, WorldCenter, WorldRotation);
+
+        return World->OverlapBlockingTestByChannel(
+            WorldCenter,
+            WorldRotation,
+            ECC_Visibility,
+            Shape.MakeCollisionShape(ItemTransform.GetScale3D(), PlacementShrinkFactor),
+            QueryParams
+        );
+    }
+
+    /** Shared body of the batch validators. */
+    static int32 ValidateShapeBatch(
+        const UObject* WorldContextObject,
+        const FSandboxPlacementShape& Shape,
+        const FTransform& Origin,
+        const TArray<FTransform>& RelativeTransforms,
+        AActor* IgnoredActor,
+        TArray<FTransform>& OutWorldTransforms,
+        TArray<bool>& OutValidSlots)
+    {
+        const int32 SlotCount = RelativeTransforms.Num();
+        OutWorldTransforms.SetNum(SlotCount);
+        OutValidSlots.Init(true, SlotCount);
+
+        for (int32 SlotIndex = 0; SlotIndex < SlotCount; ++SlotIndex)
+        {
+            OutWorldTransforms[SlotIndex] = RelativeTransforms[SlotIndex] * Origin;
+        }
+
+        // Same rule as IsPlacementValid: nothing to test means nothing blocks
+        if (!Shape.IsValid() || SlotCount == 0) return SlotCount;
+
+        UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+        if (!World)
+        {
+            OutValidSlots.Init(false, SlotCount);
+            return 0;
+        }
+
+        const FCollisionQueryParams QueryParams = MakePlacementQueryParams(IgnoredActor);
+
+        // OPTIMIZATION: Scene queries are read-only, large stamps fan out over the task threads
+        ParallelFor(SlotCount, [&](int32 SlotIndex)
+        {
+            OutValidSlots[SlotIndex] = !IsShapeBlocked(World, Shape, OutWorldTransforms[SlotIndex], QueryParams);
+        }, SlotCount < ParallelBatchThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+        int32 ValidCount = 0;
+        for (bool bValid : OutValidSlots)
+        {
+            ValidCount += bValid ? 1 : 0;
+        }
+        return ValidCount;
+    }
+}
+
 bool USandboxUtils::CalculatePlacementTransform(
     const UObject* WorldContextObject,
     const FVector CameraLocation,
@@ -34,46 +193,65 @@ bool USandboxUtils::CalculatePlacementTransform(
 
     bool bHit = World->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_Visibility, QueryParams);
 
-    FQuat YawRotation(FVector::UpVector, FMath::DegreesToRadians(AdditionalYaw));
+    return SandboxPlacement::MakePlacementTransform(bHit, HitResult, TraceStart, CameraForward, TraceDistance, GridSize, bAlignToNormal, AdditionalYaw, OutTransform);
+}
 
-    if (bHit)
-    {
-        FVector FinalLocation = HitResult.Location;
-        FQuat FinalRotation = FQuat::Identity;
+bool USandboxUtils::CalculatePlacementTransformFromView(
+    APlayerController* PlayerController,
+    float TraceDistance,
+    float GridSize,
+    bool bAlignToNormal,
+    float AdditionalYaw,
+    FTransform& OutTransform)
+{
+    if (!PlayerController) return false;
 
-        if (GridSize > 0.0f)
-        {
-            FinalLocation.X = FMath::GridSnap(FinalLocation.X, GridSize);
-            FinalLocation.Y = FMath::GridSnap(FinalLocation.Y, GridSize);
-        }
+    USandboxViewQuerySubsystem* ViewQuery = USandboxViewQuerySubsystem::Get(PlayerController);
+    if (!ViewQuery)
+    {
+        FVector ViewLocation;
+        FRotator ViewRotation;
+        PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+        return CalculatePlacementTransform(PlayerController, ViewLocation, ViewRotation.Vector(), TraceDistance, GridSize, bAlignToNormal, AdditionalYaw, OutTransform);
+    }
 
-        if (bAlignToNormal)
-        {
-            FinalRotation = FRotationMatrix::MakeFromZ(HitResult.ImpactNormal).ToQuat();
-        }
+    FSandboxViewHit ViewHit;
+    ViewQuery->GetViewHit(PlayerController, TraceDistance, ViewHit);
 
-        FinalRotation = FinalRotation * YawRotation;
+    return SandboxPlacement::MakePlacementTransform(ViewHit.bHit, ViewHit.Hit, ViewHit.ViewLocation, ViewHit.ViewRotation.Vector(), TraceDistance, GridSize, bAlignToNormal, AdditionalYaw, OutTransform);
+}
 
-        OutTransform.SetLocation(FinalLocation);
-        OutTransform.SetRotation(FinalRotation);
-        OutTransform.SetScale3D(FVector(1.0f));
-        return true;
+bool USandboxUtils::CalculatePlacementTransformAsync(
+    const UObject* WorldContextObject,
+    const FVector CameraLocation,
+    const FVector CameraForward,
+    float TraceDistance,
+    float GridSize,
+    bool bAlignToNormal,
+    float AdditionalYaw,
+    FTransform& OutTransform)
+{
+    USandboxPlacementQuerySubsystem* QuerySubsystem = USandboxPlacementQuerySubsystem::Get(WorldContextObject);
+    if (!QuerySubsystem)
+    {
+        return CalculatePlacementTransform(WorldContextObject, CameraLocation, CameraForward, TraceDistance, GridSize, bAlignToNormal, AdditionalYaw, OutTransform);
     }
 
-    // Sky Logic
-    FVector FloatingLocation = TraceStart + (CameraForward * (TraceDistance * 0.5f));
-    if (GridSize > 0.0f)
+    FVector TraceStart = CameraLocation;
+    FVector TraceEnd = TraceStart + (CameraForward * TraceDistance);
+
+    FCollisionQueryParams QueryParams;
+    QueryParams.bTraceComplex = false;
+
+    FHitResult HitResult;
+    bool bHit = false;
+    if (!QuerySubsystem->RequestLineTrace(WorldContextObject, TraceStart, TraceEnd, ECC_Visibility, QueryParams, HitResult, bHit))
     {
-        FloatingLocation.X = FMath::GridSnap(FloatingLocation.X, GridSize);
-        FloatingLocation.Y = FMath::GridSnap(FloatingLocation.Y, GridSize);
-        FloatingLocation.Z = FMath::GridSnap(FloatingLocation.Z, GridSize);
+        // First frame of the preview, nothing traced yet
+        return CalculatePlacementTransform(WorldContextObject, CameraLocation, CameraForward, TraceDistance, GridSize, bAlignToNormal, AdditionalYaw, OutTransform);
     }
 
-    OutTransform.SetLocation(FloatingLocation);
-    OutTransform.SetRotation(YawRotation);
-    OutTransform.SetScale3D(FVector(1.0f));
-
-    return false;
+    return SandboxPlacement::MakePlacementTransform(bHit, HitResult, TraceStart, CameraForward, TraceDistance, GridSize, bAlignToNormal, AdditionalYaw, OutTransform);
 }
 
 bool USandboxUtils::IsPlacementValid(
@@ -88,32 +266,133 @@ bool USandboxUtils::IsPlacementValid(
     UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
     if (!World) return false;
 
-    FVector Min, Max;
-    MeshComponent->GetLocalBounds(Min, Max);
-    FVector LocalCenter = (Min + Max) * 0.5f;
-    FVector BoxExtent = (Max - Min) * 0.5f;
-    BoxExtent *= 0.95f; // Shrink to avoid floor contact
-
-    FVector WorldCenter = ItemLocation + ItemRotation.RotateVector(LocalCenter);
-
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(IgnoredActor);
-    if (IgnoredActor && IgnoredActor->GetOwner())
-    {
-        QueryParams.AddIgnoredActor(IgnoredActor->GetOwner());
-    }
+    FVector WorldCenter, BoxExtent;
+    SandboxPlacement::GetPlacementBox(MeshComponent, ItemLocation, ItemRotation, WorldCenter, BoxExtent);
 
     bool bHit = World->OverlapBlockingTestByChannel(
         WorldCenter,
         ItemRotation,
         ECC_Visibility,
         FCollisionShape::MakeBox(BoxExtent),
-        QueryParams
+        SandboxPlacement::MakePlacementQueryParams(IgnoredActor)
     );
 
     return !bHit;
 }
 
+bool USandboxUtils::IsItemPlacementValid(
+    const UObject* WorldContextObject,
+    USandboxItemData* ItemData,
+    const FTransform& ItemTransform,
+    AActor* IgnoredActor)
+{
+    if (!WorldContextObject || !ItemData) return true;
+
+    if (!ItemData->HasPlacementData() && !ItemData->RefreshPlacementData(false)) return true;
+
+    UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+    if (!World) return false;
+
+    return !SandboxPlacement::IsShapeBlocked(World, ItemData->PlacementShape, ItemTransform, SandboxPlacement::MakePlacementQueryParams(IgnoredActor));
+}
+
+bool USandboxUtils::IsPlacementValidAsync(
+    const UObject* WorldContextObject,
+    const FVector ItemLocation,
+    const FQuat ItemRotation,
+    UStaticMeshComponent* MeshComponent,
+    AActor* IgnoredActor)
+{
+    if (!WorldContextObject || !MeshComponent || !MeshComponent->GetStaticMesh()) return true;
+
+    USandboxPlacementQuerySubsystem* QuerySubsystem = USandboxPlacementQuerySubsystem::Get(WorldContextObject);
+    if (!QuerySubsystem)
+    {
+        return IsPlacementValid(WorldContextObject, ItemLocation, ItemRotation, MeshComponent, IgnoredActor);
+    }
+
+    FVector WorldCenter, BoxExtent;
+    SandboxPlacement::GetPlacementBox(MeshComponent, ItemLocation, ItemRotation, WorldCenter, BoxExtent);
+
+    bool bBlocked = false;
+    if (QuerySubsystem->RequestPlacementOverlap(WorldContextObject, ItemLocation, ItemRotation, MeshComponent->GetStaticMesh(), IgnoredActor,
+        WorldCenter, BoxExtent, SandboxPlacement::MakePlacementQueryParams(IgnoredActor), bBlocked))
+    {
+        return !bBlocked;
+    }
+
+    // First frame of the preview: answer synchronously once and seed the cache
+    const bool bValid = IsPlacementValid(WorldContextObject, ItemLocation, ItemRotation, MeshComponent, IgnoredActor);
+    QuerySubsystem->StorePlacementResult(WorldContextObject, ItemLocation, ItemRotation, MeshComponent->GetStaticMesh(), IgnoredActor, !bValid);
+    return bValid;
+}
+
+void USandboxUtils::InvalidatePlacementCache(const UObject* WorldContextObject)
+{
+    if (USandboxPlacementQuerySubsystem* QuerySubsystem = USandboxPlacementQuerySubsystem::Get(WorldContextObject))
+    {
+        QuerySubsystem->InvalidateCache();
+    }
+}
+
+int32 USandboxUtils::ValidatePlacementBatch(
+    const UObject* WorldContextObject,
+    const FTransform& Origin,
+    const TArray<FTransform>& RelativeTransforms,
+    const FBox& LocalBounds,
+    AActor* IgnoredActor,
+    TArray<FTransform>& OutWorldTransforms,
+    TArray<bool>& OutValidSlots)
+{
+    const FSandboxPlacementShape Shape = LocalBounds.IsValid ? FSandboxPlacementShape::MakeBox(LocalBounds) : FSandboxPlacementShape();
+    return SandboxPlacement::ValidateShapeBatch(WorldContextObject, Shape, Origin, RelativeTransforms, IgnoredActor, OutWorldTransforms, OutValidSlots);
+}
+
+int32 USandboxUtils::ValidateItemPlacementBatch(
+    const UObject* WorldContextObject,
+    USandboxItemData* ItemData,
+    const FTransform& Origin,
+    const TArray<FTransform>& RelativeTransforms,
+    AActor* IgnoredActor,
+    TArray<FTransform>& OutWorldTransforms,
+    TArray<bool>& OutValidSlots)
+{
+    // Uncooked assets fill the shape on first use if the ghost mesh is resident
+    if (ItemData && !ItemData->HasPlacementData())
+    {
+        ItemData->RefreshPlacementData(false);
+    }
+
+    const FSandboxPlacementShape Shape = ItemData ? ItemData->PlacementShape : FSandboxPlacementShape();
+    return SandboxPlacement::ValidateShapeBatch(WorldContextObject, Shape, Origin, RelativeTransforms, IgnoredActor, OutWorldTransforms, OutValidSlots);
+}
+
+int32 USandboxUtils::SpawnPlacementBatch(
+    const UObject* WorldContextObject,
+    USandboxItemData* ItemData,
+    const TArray<FTransform>& WorldTransforms,
+    const TArray<bool>& ValidSlots)
+{
+    USandboxItemRegistry* Registry = USandboxItemRegistry::Get(WorldContextObject);
+    ASandboxWorldManager* WorldManager = Registry ? Registry->GetWorldManager() : nullptr;
+    if (!WorldManager || !ItemData) return 0;
+
+    // Slots without a validity entry were never tested, a mismatched batch spawns nothing
+    if (ValidSlots.Num() != WorldTransforms.Num()) return 0;
+
+    TArray<FTransform> ValidTransforms;
+    ValidTransforms.Reserve(WorldTransforms.Num());
+    for (int32 SlotIndex = 0; SlotIndex < WorldTransforms.Num(); ++SlotIndex)
+    {
+        if (ValidSlots[SlotIndex])
+        {
+            ValidTransforms.Add(WorldTransforms[SlotIndex]);
+        }
+    }
+
+    return WorldManager->QueueItemSpawns(ItemData, ValidTransforms);
+}
+
 // =========================================================================
 // SETTINGS
 // =========================================================================
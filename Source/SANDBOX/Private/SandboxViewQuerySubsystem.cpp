@@ -0,0 +1,96 @@
+#include "SandboxViewQuerySubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+USandboxViewQuerySubsystem* USandboxViewQuerySubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<USandboxViewQuerySubsystem>() : nullptr;
+}
+
+bool USandboxViewQuerySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool USandboxViewQuerySubsystem::GetViewHit(APlayerController* PlayerController, float TraceDistance, FSandboxViewHit& OutViewHit, bool bForceFresh)
+{
+    if (!PlayerController) return false;
+
+    const TObjectKey<APlayerController> PlayerKey(PlayerController);
+    FCachedViewHit* Cached = ViewHits.Find(PlayerKey);
+    if (!Cached)
+    {
+        // Controllers of players that left
+        for (auto It = ViewHits.CreateIterator(); It; ++It)
+        {
+            if (!It.Key().ResolveObjectPtr())
+            {
+                It.RemoveCurrent();
+            }
+        }
+        Cached = &ViewHits.Add(PlayerKey);
+    }
+
+    // Demand is tracked per frame, last frame's longest caller sizes this frame's first trace
+    if (Cached->RequestFrame != GFrameCounter)
+    {
+        Cached->PreviousRequestedDistance = (Cached->RequestFrame + 1 == GFrameCounter) ? Cached->RequestedDistance : 0.0f;
+        Cached->RequestedDistance = 0.0f;
+        Cached->RequestFrame = GFrameCounter;
+    }
+    Cached->RequestedDistance = FMath::Max(Cached->RequestedDistance, TraceDistance);
+
+    // OPTIMIZATION: One trace per player per frame, long enough for every caller that frame
+    const bool bReusable = !bForceFresh && Cached->bValid && Cached->FrameNumber == GFrameCounter
+        && TraceDistance <= Cached->ViewHit.TraceDistance;
+    if (bReusable)
+    {
+        TracesShared++;
+    }
+    else
+    {
+        const float SharedDistance = FMath::Max3(Cached->RequestedDistance, Cached->PreviousRequestedDistance, SharedTraceDistance);
+        TraceView(PlayerController, SharedDistance, *Cached);
+    }
+
+    OutViewHit = Cached->ViewHit;
+    OutViewHit.TraceDistance = TraceDistance;
+
+    // Clip the shared ray to the caller's reach
+    if (OutViewHit.bHit && OutViewHit.Hit.Distance > TraceDistance)
+    {
+        OutViewHit.bHit = false;
+        OutViewHit.Hit = FHitResult();
+    }
+    return true;
+}
+
+void USandboxViewQuerySubsystem::InvalidateViewHits()
+{
+    for (auto& Pair : ViewHits)
+    {
+        Pair.Value.bValid = false;
+    }
+}
+
+void USandboxViewQuerySubsystem::TraceView(APlayerController* PlayerController, float TraceDistance, FCachedViewHit& OutCached)
+{
+    FSandboxViewHit& ViewHit = OutCached.ViewHit;
+    PlayerController->GetPlayerViewPoint(ViewHit.ViewLocation, ViewHit.ViewRotation);
+    ViewHit.TraceDistance = TraceDistance;
+
+    const FVector TraceEnd = ViewHit.ViewLocation + ViewHit.ViewRotation.Vector() * TraceDistance;
+
+    FCollisionQueryParams Params;
+    Params.bTraceComplex = false;
+    Params.AddIgnoredActor(PlayerController->GetPawn());
+
+    ViewHit.Hit = FHitResult();
+    ViewHit.bHit = GetWorld()->LineTraceSingleByChannel(ViewHit.Hit, ViewHit.ViewLocation, TraceEnd, ECC_Visibility, Params);
+
+    OutCached.FrameNumber = GFrameCounter;
+    OutCached.bValid = true;
+    TracesPerformed++;
+}
\ No newline at end of file
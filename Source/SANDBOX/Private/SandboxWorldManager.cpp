@@ -1,259 +1,2203 @@
 #include "SandboxWorldManager.h"
 #include "SandboxIdentityComponent.h" 
 #include "SandboxItemData.h"          
+#include "SandboxItemRegistry.h"
+#include "SandboxPhysicsSleepSubsystem.h"
+#include "SandboxViewQuerySubsystem.h"
 #include "Kismet/GameplayStatics.h"
-#include "EngineUtils.h"
+#include "Engine/AssetManager.h"
+#include "Async/Async.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Pawn.h"
+#include "Algo/Sort.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "TimerManager.h"
 
 ASandboxWorldManager::ASandboxWorldManager()
 {
     PrimaryActorTick.bCanEverTick = true;
     // OPTIMIZATION: Tick disabled by default. Enabled only during loading.
     PrimaryActorTick.bStartWithTickEnabled = false;
+
+    // Instance batches attach here
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ASandboxWorldManager::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this))
+    {
+        Registry->SetWorldManager(this);
+    }
+
+    // OPTIMIZATION: Collapse passes run on a timer, the manager does not tick outside loading
+    GetWorldTimerManager().SetTimer(InstancingTimerHandle, this, &ASandboxWorldManager::CollapseRestingItems, InstancingInterval, true);
+}
+
+void ASandboxWorldManager::SaveWorld()
+{
+    // Coalesce: any number of requests during a save or load collapse into one follow-up save
+    if (SaveStage != ESaveStage::Idle || bIsLoading)
+    {
+        bSaveQueued = true;
+        return;
+    }
+
+    if (WorkingSaveGame)
+    {
+        BeginSave();
+        return;
+    }
+
+    // 1. Read the existing slot once, in the background, to preserve data from other levels
+    SaveStage = ESaveStage::LoadingSlot;
+    if (UGameplayStatics::DoesSaveGameExist(SaveSlotName, 0))
+    {
+        UGameplayStatics::AsyncLoadGameFromSlot(
+            SaveSlotName, 0,
+            FAsyncLoadGameFromSlotDelegate::CreateUObject(this, &ASandboxWorldManager::OnWorkingSaveLoaded)
+        );
+        return;
+    }
+
+    OnWorkingSaveLoaded(SaveSlotName, 0, nullptr);
+}
+
+void ASandboxWorldManager::CompactSave()
+{
+    bCompactionRequested = true;
+    SaveWorld();
+}
+
+FString ASandboxWorldManager::GetJournalSlotName() const
+{
+    return SaveSlotName + TEXT("_Journal");
+}
+
+void ASandboxWorldManager::OnWorkingSaveLoaded(const FString& SlotName, const int32 UserIndex, USaveGame* LoadedSave)
+{
+    // Superseded by a synchronous flush
+    if (SaveStage != ESaveStage::LoadingSlot) return;
+
+    PendingBaseSave = Cast<USandboxSaveGame>(LoadedSave);
+
+    // 2. Then the journal of changes recorded since that base was written
+    if (PendingBaseSave && UGameplayStatics::DoesSaveGameExist(GetJournalSlotName(), 0))
+    {
+        UGameplayStatics::AsyncLoadGameFromSlot(
+            GetJournalSlotName(), 0,
+            FAsyncLoadGameFromSlotDelegate::CreateUObject(this, &ASandboxWorldManager::OnWorkingJournalLoaded)
+        );
+        return;
+    }
+
+    OnWorkingJournalLoaded(GetJournalSlotName(), 0, nullptr);
+}
+
+void ASandboxWorldManager::OnWorkingJournalLoaded(const FString& SlotName, const int32 UserIndex, USaveGame* LoadedJournal)
+{
+    if (SaveStage != ESaveStage::LoadingSlot) return;
+
+    AdoptWorkingSave(PendingBaseSave, Cast<USandboxSaveJournal>(LoadedJournal));
+    PendingBaseSave = nullptr;
+
+    if (!WorkingSaveGame)
+    {
+        FinishSave(false);
+        return;
+    }
+
+    BeginSave();
+}
+
+void ASandboxWorldManager::LoadWorkingSaveBlocking()
+{
+    USandboxSaveGame* Base = nullptr;
+    USandboxSaveJournal* Journal = nullptr;
+
+    if (UGameplayStatics::DoesSaveGameExist(SaveSlotName, 0))
+    {
+        Base = Cast<USandboxSaveGame>(UGameplayStatics::LoadGameFromSlot(SaveSlotName, 0));
+    }
+
+    if (Base && UGameplayStatics::DoesSaveGameExist(GetJournalSlotName(), 0))
+    {
+        Journal = Cast<USandboxSaveJournal>(UGameplayStatics::LoadGameFromSlot(GetJournalSlotName(), 0));
+    }
+
+    AdoptWorkingSave(Base, Journal);
+}
+
+void ASandboxWorldManager::AdoptWorkingSave(USandboxSaveGame* Base, USandboxSaveJournal* Journal)
+{
+    WorkingSaveGame = Base;
+
+    // Create new if invalid
+    if (!WorkingSaveGame)
+    {
+        WorkingSaveGame = Cast<USandboxSaveGame>(UGameplayStatics::CreateSaveGameObject(USandboxSaveGame::StaticClass()));
+    }
+
+    PaletteIndexCache.Empty();
+    if (!WorkingSaveGame) return;
+
+    // A journal recorded against another base revision is stale and ignored
+    if (Journal && WorkingSaveGame->ApplyJournal(*Journal))
+    {
+        WorkingJournal = Journal;
+    }
+    else
+    {
+        WorkingJournal = Cast<USandboxSaveJournal>(UGameplayStatics::CreateSaveGameObject(USandboxSaveJournal::StaticClass()));
+        WorkingJournal->Reset(WorkingSaveGame->SaveRevision);
+    }
+}
+
+int32 ASandboxWorldManager::ResolvePaletteIndex(USandboxItemData* ItemData)
+{
+    // Resolve each data asset's path once instead of once per item
+    if (int32* Found = PaletteIndexCache.Find(ItemData))
+    {
+        return *Found;
+    }
+
+    FString AssetPath = ItemData->GetPathName();
+    int32 PaletteIndex = WorkingSaveGame->AssetPalette.Find(AssetPath);
+    if (PaletteIndex == INDEX_NONE)
+    {
+        PaletteIndex = WorkingSaveGame->AssetPalette.Add(AssetPath);
+    }
+
+    PaletteIndexCache.Add(ItemData, PaletteIndex);
+    return PaletteIndex;
+}
+
+void ASandboxWorldManager::BeginSave()
+{
+    // Incremental saves are only valid while the tracked world state matches the working save
+    const bool bCanSaveIncrementally =
+        bIncrementalSaves &&
+        bWorldMatchesSave &&
+        !bCompactionRequested &&
+        WorkingJournal &&
+        WorkingJournal->GetRecordCount() < JournalCompactionThreshold &&
+        (IncrementalSavesPerCompaction <= 0 || IncrementalSavesSinceCompaction < IncrementalSavesPerCompaction);
+
+    if (bCanSaveIncrementally)
+    {
+        BeginIncrementalSave();
+    }
+    else
+    {
+        BeginSaveSnapshot();
+    }
+}
+
+void ASandboxWorldManager::BeginIncrementalSave()
+{
+    USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this);
+    if (!Registry)
+    {
+        FinishSave(false);
+        return;
+    }
+
+    TArray<USandboxIdentityComponent*> DirtyItems;
+    TArray<int32> RemovedItemIds;
+    Registry->ConsumeChanges(DirtyItems, RemovedItemIds);
+
+    if (DirtyItems.Num() == 0 && RemovedItemIds.Num() == 0)
+    {
+        FinishSave(true);
+        return;
+    }
+
+    const FString LevelName = UGameplayStatics::GetCurrentLevelName(this);
+    FSavedLevelData& Level = WorkingSaveGame->FindOrAddLevel(LevelName);
+
+    // --- DELTA (game thread, O(changes)) ---
+    // Applied to the working save as well, so it stays the current state for loads and compaction
+    for (int32 RemovedId : RemovedItemIds)
+    {
+        Level.RemoveItem(RemovedId);
+        WorkingJournal->RecordRemoval(LevelName, RemovedId);
+    }
+
+    for (USandboxIdentityComponent* Identity : DirtyItems)
+    {
+        AActor* Actor = Identity->GetOwner();
+        if (!IsValid(Actor)) continue;
+
+        // Destroyed by damage: no longer part of the save
+        if (!Identity->SourceItemData)
+        {
+            if (Identity->ItemId != 0)
+            {
+                Level.RemoveItem(Identity->ItemId);
+                WorkingJournal->RecordRemoval(LevelName, Identity->ItemId);
+                Identity->ItemId = 0;
+            }
+            continue;
+        }
+
+        if (Identity->ItemId == 0)
+        {
+            Identity->ItemId = Level.NextItemId++;
+        }
+
+        FSavedItemCompact CompactItem;
+        CompactItem.PaletteIndex = ResolvePaletteIndex(Identity->SourceItemData);
+        CompactItem.ItemId = Identity->ItemId;
+        CaptureItemState(Actor, CompactItem);
+
+        Level.UpsertItem(CompactItem);
+        WorkingJournal->RecordUpsert(LevelName, CompactItem);
+    }
+
+    WorkingJournal->AssetPalette = WorkingSaveGame->AssetPalette;
+    IncrementalSavesSinceCompaction++;
+
+    // --- WRITE (journal slot only) ---
+    SaveStage = ESaveStage::Writing;
+    bWritingJournal = true;
+    UGameplayStatics::AsyncSaveGameToSlot(
+        WorkingJournal, GetJournalSlotName(), 0,
+        FAsyncSaveGameToSlotDelegate::CreateUObject(this, &ASandboxWorldManager::OnAsyncSaveFinished)
+    );
+}
+
+void ASandboxWorldManager::CaptureLevelSnapshot(FSavedLevelData& OutSnapshot)
+{
+    OutSnapshot.LevelName = UGameplayStatics::GetCurrentLevelName(this);
+    OutSnapshot.Items.Reset();
+    OutSnapshot.InvalidateItemIndex();
+
+    UWorld* World = GetWorld();
+    if (!World || !WorkingSaveGame) return;
+
+    // Ids continue from the existing block so journal records stay unambiguous
+    OutSnapshot.NextItemId = WorkingSaveGame->FindOrAddLevel(OutSnapshot.LevelName).NextItemId;
+
+    USandboxItemRegistry* Registry = World->GetSubsystem<USandboxItemRegistry>();
+    if (!Registry) return;
+
+    // Streamed levels: items in unloaded cells only exist in the working save.
+    // The same holds for items a time-sliced load has not spawned yet.
+    const bool bMergeWithBlock = bStreamingActive || bIsLoading;
+    if (bMergeWithBlock)
+    {
+        FSavedLevelData& Level = WorkingSaveGame->FindOrAddLevel(OutSnapshot.LevelName);
+        OutSnapshot.Items = Level.Items;
+        OutSnapshot.InvalidateItemIndex();
+
+        TArray<USandboxIdentityComponent*> DirtyItems;
+        TArray<int32> RemovedItemIds;
+        Registry->ConsumeChanges(DirtyItems, RemovedItemIds);
+        for (int32 RemovedId : RemovedItemIds)
+        {
+            OutSnapshot.RemoveItem(RemovedId);
+        }
+    }
+    else
+    {
+        // The snapshot covers every item, pending deltas are superseded
+        Registry->ClearChanges();
+    }
+
+    // Only sandbox items are visited, not every actor in the world
+    for (USandboxIdentityComponent* Identity : Registry->GetItems())
+    {
+        AActor* Actor = Identity ? Identity->GetOwner() : nullptr;
+        if (!IsValid(Actor)) continue;
+
+        if (Identity->SourceItemData)
+        {
+            if (Identity->ItemId == 0)
+            {
+                Identity->ItemId = OutSnapshot.NextItemId++;
+            }
+
+            FSavedItemCompact CompactItem;
+            CompactItem.PaletteIndex = ResolvePaletteIndex(Identity->SourceItemData);
+            CompactItem.ItemId = Identity->ItemId;
+            CaptureItemState(Actor, CompactItem);
+
+            if (bMergeWithBlock)
+            {
+                OutSnapshot.UpsertItem(CompactItem);
+            }
+            else
+            {
+                OutSnapshot.Items.Add(CompactItem);
+            }
+        }
+        else if (bMergeWithBlock && Identity->ItemId != 0)
+        {
+            // Destroyed by damage
+            OutSnapshot.RemoveItem(Identity->ItemId);
+        }
+    }
+
+    // Instanced items have no identity component, their records are saved directly
+    for (const TPair<TObjectPtr<USandboxItemData>, FSandboxInstanceBatch>& Entry : InstanceBatches)
+    {
+        const int32 PaletteIndex = ResolvePaletteIndex(Entry.Key);
+        for (const FSandboxInstancedItem& Item : Entry.Value.Items)
+        {
+            FSavedItemCompact CompactItem;
+            CompactItem.PaletteIndex = PaletteIndex;
+            CompactItem.ItemId = Item.ItemId;
+            CompactItem.Transform = Item.ActorTransform;
+            CompactItem.Physics.bAsleep = true;
+
+            if (bMergeWithBlock)
+            {
+                OutSnapshot.UpsertItem(CompactItem);
+            }
+            else
+            {
+                OutSnapshot.Items.Add(CompactItem);
+            }
+        }
+    }
+
+    // Non-streamed captures append directly
+    if (!bMergeWithBlock)
+    {
+        OutSnapshot.InvalidateItemIndex();
+    }
+
+    bWorldMatchesSave = true;
+}
+
+void ASandboxWorldManager::BeginSaveSnapshot()
+{
+    SaveStage = ESaveStage::Encoding;
+    EncodingWriteBacks.Reset();
+
+    // --- SNAPSHOT (game thread) ---
+    // Only transforms and palette indices, everything heavier happens on a worker
+    FSavedLevelData Snapshot;
+    CaptureLevelSnapshot(Snapshot);
+
+    const FSandboxTransformQuantization Settings = SaveTransformQuantization;
+    const uint32 Generation = SaveGeneration;
+    TWeakObjectPtr<ASandboxWorldManager> WeakThis(this);
+
+    // --- ENCODING (worker) ---
+    // Both encodings are packed and compressed here, the game thread only serializes the finished blob
+    Async(EAsyncExecution::ThreadPool, [WeakThis, Settings, Generation, Snapshot = MoveTemp(Snapshot)]() mutable
+        {
+            USandboxSaveGame::PackLevel(Snapshot, Settings);
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, Generation, Snapshot = MoveTemp(Snapshot)]() mutable
+                {
+                    if (ASandboxWorldManager* Manager = WeakThis.Get())
+                    {
+                        Manager->CommitSaveSnapshot(MoveTemp(Snapshot), Generation);
+                    }
+                });
+        });
+}
+
+void ASandboxWorldManager::CommitSaveSnapshot(FSavedLevelData&& Snapshot, uint32 Generation)
+{
+    // A synchronous flush already wrote newer data
+    if (Generation != SaveGeneration || !WorkingSaveGame) return;
+
+    // Only the current level's block is replaced, other levels stay untouched
+    const FString LevelName = Snapshot.LevelName;
+    FSavedLevelData& Level = WorkingSaveGame->FindOrAddLevel(LevelName);
+    Level = MoveTemp(Snapshot);
+    WorkingSaveGame->TransformQuantization = SaveTransformQuantization;
+
+    // Items streamed out during encoding were pooled clean, the snapshot is their only record
+    for (const TPair<int32, FSavedItemCompact>& WriteBack : EncodingWriteBacks)
+    {
+        Level.UpsertItem(WriteBack.Value);
+    }
+    EncodingWriteBacks.Reset();
+
+    // --- COMPACTION ---
+    // The new base contains every journaled change, the journal restarts against it
+    WorkingSaveGame->SaveRevision++;
+    WorkingJournal->Reset(WorkingSaveGame->SaveRevision);
+
+    // --- WRITE (serialized here, written to disk on a worker) ---
+    // Packed level blocks serialize as plain byte arrays, only a write-back re-applied above repacks its level here
+    SaveStage = ESaveStage::Writing;
+    bWritingJournal = false;
+    UGameplayStatics::AsyncSaveGameToSlot(
+        WorkingSaveGame, SaveSlotName, 0,
+        FAsyncSaveGameToSlotDelegate::CreateUObject(this, &ASandboxWorldManager::OnAsyncSaveFinished)
+    );
+
+    if (GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Green, FString::Printf(TEXT("Saved items for level: %s"), *LevelName));
+    }
+}
+
+void ASandboxWorldManager::OnAsyncSaveFinished(const FString& SlotName, const int32 UserIndex, bool bSuccess)
+{
+    if (SaveStage != ESaveStage::Writing) return;
+
+    if (!bWritingJournal && bSuccess)
+    {
+        OnFullSaveWritten();
+    }
+
+    // Changes consumed by a failed write are only recoverable through a full snapshot
+    if (!bSuccess)
+    {
+        bCompactionRequested = true;
+    }
+
+    FinishSave(bSuccess);
+}
+
+void ASandboxWorldManager::OnFullSaveWritten()
+{
+    // The old journal on disk references the previous revision, drop it
+    if (UGameplayStatics::DoesSaveGameExist(GetJournalSlotName(), 0))
+    {
+        UGameplayStatics::DeleteGameInSlot(GetJournalSlotName(), 0);
+    }
+
+    IncrementalSavesSinceCompaction = 0;
+    bCompactionRequested = false;
+}
+
+void ASandboxWorldManager::FinishSave(bool bSuccess)
+{
+    SaveStage = ESaveStage::Idle;
+    OnSaveCompleted.Broadcast(bSuccess);
+
+    if (bLoadQueued)
+    {
+        bLoadQueued = false;
+        LoadWorld();
+    }
+    else if (bSaveQueued)
+    {
+        bSaveQueued = false;
+        SaveWorld();
+    }
+}
+
+void ASandboxWorldManager::SaveWorldImmediate()
+{
+    // Drop any snapshot still being encoded, this save supersedes it
+    SaveGeneration++;
+    bSaveQueued = false;
+
+    if (!WorkingSaveGame)
+    {
+        LoadWorkingSaveBlocking();
+    }
+
+    if (!WorkingSaveGame) return;
+
+    // Streamed write-backs are already in the block the capture copies from
+    EncodingWriteBacks.Reset();
+
+    FSavedLevelData Snapshot;
+    CaptureLevelSnapshot(Snapshot);
+    WorkingSaveGame->FindOrAddLevel(Snapshot.LevelName) = MoveTemp(Snapshot);
+    WorkingSaveGame->TransformQuantization = SaveTransformQuantization;
+    WorkingSaveGame->SaveRevision++;
+    WorkingJournal->Reset(WorkingSaveGame->SaveRevision);
+
+    const bool bSuccess = UGameplayStatics::SaveGameToSlot(WorkingSaveGame, SaveSlotName, 0);
+    if (bSuccess)
+    {
+        OnFullSaveWritten();
+    }
+
+    SaveStage = ESaveStage::Idle;
+    OnSaveCompleted.Broadcast(bSuccess);
+}
+
+void ASandboxWorldManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Background work would be lost with the manager, flush it while actors are still alive.
+    // Never while a write is in flight: a second, synchronous write to the same slot would race it.
+    if (SaveStage != ESaveStage::Writing &&
+        (bSaveQueued || SaveStage == ESaveStage::LoadingSlot || SaveStage == ESaveStage::Encoding))
+    {
+        SaveWorldImmediate();
+    }
+
+    CancelAssetPreload();
+    CancelQueuedClassLoads();
+
+    GetWorldTimerManager().ClearTimer(InstancingTimerHandle);
+
+    USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this);
+    if (Registry && Registry->GetWorldManager() == this)
+    {
+        Registry->SetWorldManager(nullptr);
+    }
+
+    // Hidden pooled actors would outlive the manager otherwise (world teardown cleans them up itself)
+    if (EndPlayReason == EEndPlayReason::Destroyed || EndPlayReason == EEndPlayReason::RemovedFromWorld)
+    {
+        EmptyActorPool();
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ASandboxWorldManager::LoadWorld()
+{
+    // The working save is about to change, load once it has settled
+    if (SaveStage != ESaveStage::Idle)
+    {
+        bLoadQueued = true;
+        return;
+    }
+
+    // The working save always mirrors the last written state of the slot (base + journal)
+    if (!WorkingSaveGame)
+    {
+        if (!UGameplayStatics::DoesSaveGameExist(SaveSlotName, 0)) return;
+        LoadWorkingSaveBlocking();
+    }
+
+    CancelAssetPreload();
+
+    CachedSaveGame = WorkingSaveGame;
+    if (!CachedSaveGame) return;
+
+    UWorld* World = GetWorld();
+    if (!World) return;
+
+    // Tracked changes are meaningless until the loaded state is in place
+    bWorldMatchesSave = false;
+
+    // Cells are rebuilt from the working save below
+    StopStreaming();
+
+    // --- CLEANUP SCENE ---
+    // Items of an interrupted load are about to be pooled, they must not be woken later
+    HeldPhysicsActors.Reset();
+    HeldPhysicsStates.Reset();
+
+    // Stamps queued against the old world state are dropped
+    SpawnQueue.Reset();
+    SpawnQueueCursor = 0;
+    CancelQueuedClassLoads();
+
+    ClearInstanceBatches();
+
+    // Return existing constructed items to the pool (copy, releasing unregisters from the live list)
+    if (USandboxItemRegistry* Registry = World->GetSubsystem<USandboxItemRegistry>())
+    {
+        const TArray<TObjectPtr<USandboxIdentityComponent>> ExistingItems = Registry->GetItems();
+        for (USandboxIdentityComponent* Identity : ExistingItems)
+        {
+            if (Identity && IsValid(Identity->GetOwner()))
+            {
+                ReleaseItem(Identity->GetOwner());
+            }
+        }
+
+        // Those removals belong to the old world state, the items are about to be spawned again
+        Registry->ClearChanges();
+    }
+
+    ClassCache.Empty();
+    DataAssetCache.Empty();
+    CurrentLoadIndex = 0;
+
+    FString CurrentLevelName = UGameplayStatics::GetCurrentLevelName(this);
+    CachedLevelIndex = CachedSaveGame->Levels.IndexOfByPredicate([&CurrentLevelName](const FSavedLevelData& Level)
+        {
+            return Level.LevelName == CurrentLevelName;
+        });
+
+    // Streamed levels stay active even when empty, items placed later stream out and back in
+    if (bStreamItemsByCell && !CachedSaveGame->Levels.IsValidIndex(CachedLevelIndex))
+    {
+        CachedSaveGame->FindOrAddLevel(CurrentLevelName);
+        CachedLevelIndex = CachedSaveGame->Levels.Num() - 1;
+    }
+
+    if (bStreamItemsByCell && CachedSaveGame->Levels[CachedLevelIndex].Items.Num() == 0)
+    {
+        StartStreaming();
+        bHasLoadFocusOverride = false;
+        FinishLoadTracking();
+        SetActorTickEnabled(true);
+        OnLoadingCompleted();
+        return;
+    }
+
+    if (!CachedSaveGame->Levels.IsValidIndex(CachedLevelIndex) || CachedSaveGame->Levels[CachedLevelIndex].Items.Num() == 0)
+    {
+        CachedSaveGame = nullptr;
+        bIsLoading = false;
+        LoadCells.Reset();
+        bHasLoadFocusOverride = false;
+        FinishLoadTracking();
+        OnLoadingCompleted();
+        return;
+    }
+
+    // Items from saves without stable ids get them now; the base must be rewritten once
+    if (CachedSaveGame->Levels[CachedLevelIndex].AssignMissingItemIds())
+    {
+        bCompactionRequested = true;
+    }
+
+    if (bStreamItemsByCell)
+    {
+        // Only cells around the focus are spawned, the rest stream in as the player moves
+        StartStreaming();
+        bHasLoadFocusOverride = false;
+    }
+    else
+    {
+        // Nearest cells first, so the player's surroundings complete before distant ones
+        BuildLoadCells(CachedSaveGame->Levels[CachedLevelIndex].Items);
+    }
+
+    // Enable tick to report preload progress and run time-sliced spawning
+    SmoothedFrameTime = 0.0;
+    LastLoadSliceTime = 0.0;
+    bIsLoading = true;
+    SetActorTickEnabled(true);
+
+    StartAssetPreload();
+
+    if (GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Yellow, TEXT("Starting Async Load..."));
+    }
+}
+
+void ASandboxWorldManager::FinishLoadTracking()
+{
+    // Spawning marked every item dirty, but the world now matches the working save exactly
+    if (USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this))
+    {
+        Registry->ClearChanges();
+    }
+    bWorldMatchesSave = true;
+}
+
+void ASandboxWorldManager::StartAssetPreload()
+{
+    PreloadPaletteIndices.Reset();
+
+    // Gather unique palette entries referenced by this level
+    TSet<int32> UsedIndices;
+    for (const FSavedItemCompact& Item : CachedSaveGame->Levels[CachedLevelIndex].Items)
+    {
+        if (CachedSaveGame->AssetPalette.IsValidIndex(Item.PaletteIndex))
+        {
+            UsedIndices.Add(Item.PaletteIndex);
+        }
+    }
+
+    TArray<FSoftObjectPath> AssetsToLoad;
+    for (int32 PIndex : UsedIndices)
+    {
+        const FString& AssetPath = CachedSaveGame->AssetPalette[PIndex];
+        if (!AssetPath.IsEmpty())
+        {
+            PreloadPaletteIndices.Add(PIndex);
+            AssetsToLoad.Add(FSoftObjectPath(AssetPath));
+        }
+    }
+
+    if (AssetsToLoad.Num() == 0)
+    {
+        // Nothing to stream, spawn loop will simply skip unresolved entries
+        bIsPreloading = false;
+        return;
+    }
+
+    bIsPreloading = true;
+
+    // OPTIMIZATION: One batched request instead of a blocking load per palette entry.
+    DataAssetPreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        AssetsToLoad,
+        FStreamableDelegate::CreateUObject(this, &ASandboxWorldManager::OnDataAssetsPreloaded)
+    );
+
+    if (!DataAssetPreloadHandle.IsValid())
+    {
+        OnDataAssetsPreloaded();
+    }
+}
+
+void ASandboxWorldManager::OnDataAssetsPreloaded()
+{
+    if (!bIsPreloading || !CachedSaveGame) return;
+
+    TSet<FSoftObjectPath> ClassesToLoad;
+    for (int32 PIndex : PreloadPaletteIndices)
+    {
+        FSoftObjectPath AssetPath(CachedSaveGame->AssetPalette[PIndex]);
+        USandboxItemData* SourceData = Cast<USandboxItemData>(AssetPath.ResolveObject());
+        if (SourceData && !SourceData->ActorClassToSpawn.IsNull())
+        {
+            DataAssetCache.Add(PIndex, SourceData);
+            ClassesToLoad.Add(SourceData->ActorClassToSpawn.ToSoftObjectPath());
+        }
+    }
+
+    if (ClassesToLoad.Num() == 0)
+    {
+        OnActorClassesPreloaded();
+        return;
+    }
+
+    ClassPreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        ClassesToLoad.Array(),
+        FStreamableDelegate::CreateUObject(this, &ASandboxWorldManager::OnActorClassesPreloaded)
+    );
+
+    if (!ClassPreloadHandle.IsValid())
+    {
+        OnActorClassesPreloaded();
+    }
+}
+
+void ASandboxWorldManager::OnActorClassesPreloaded()
+{
+    if (!bIsPreloading) return;
+
+    for (const TPair<int32, USandboxItemData*>& Entry : DataAssetCache)
+    {
+        if (UClass* LoadedClass = Entry.Value->ActorClassToSpawn.Get())
+        {
+            ClassCache.Add(Entry.Key, LoadedClass);
+        }
+    }
+
+    bIsPreloading = false;
+}
+
+void ASandboxWorldManager::CancelAssetPreload()
+{
+    bIsPreloading = false;
+    PreloadPaletteIndices.Reset();
+
+    if (DataAssetPreloadHandle.IsValid())
+    {
+        DataAssetPreloadHandle->CancelHandle();
+        DataAssetPreloadHandle.Reset();
+    }
+
+    if (ClassPreloadHandle.IsValid())
+    {
+        ClassPreloadHandle->CancelHandle();
+        ClassPreloadHandle.Reset();
+    }
+}
+
+void ASandboxWorldManager::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // Queued batch spawns share the load budget, a running load goes first
+    const bool bSpawnQueuePending = !bIsLoading && SpawnQueueCursor < SpawnQueue.Num();
+    const bool bLoadPending = (bIsLoading || bStreamingActive) && CachedSaveGame != nullptr;
+
+    if (!bLoadPending)
+    {
+        if (bSpawnQueuePending)
+        {
+            // Gameplay is running, never take a loading-screen sized share of the frame
+            TickSpawnQueue(FMath::Min(ComputeLoadFrameBudget(DeltaTime), MaxFrameTimeBudget));
+        }
+        else
+        {
+            SetActorTickEnabled(false);
+        }
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    if (!World) return;
+
+    // --- PRELOAD PHASE ---
+    // Spawning waits until every referenced asset is resident
+    if (bIsPreloading)
+    {
+        float PreloadPercent = 0.0f;
+        if (ClassPreloadHandle.IsValid())
+        {
+            PreloadPercent = 0.5f + 0.5f * ClassPreloadHandle->GetProgress();
+        }
+        else if (DataAssetPreloadHandle.IsValid())
+        {
+            PreloadPercent = 0.5f * DataAssetPreloadHandle->GetProgress();
+        }
+
+        OnLoadingProgress(PreloadPercent * PreloadProgressWeight);
+        return;
+    }
+
+    // Streamed levels spawn from the cell queue instead of the whole block
+    if (bStreamingActive)
+    {
+        const double FrameBudget = ComputeLoadFrameBudget(DeltaTime);
+        if (!bSpawnQueuePending)
+        {
+            TickStreaming(FrameBudget);
+            return;
+        }
+
+        // Streaming keeps up with the player on at most half the budget, the stamp gets the rest
+        const double SpawnQueueBudget = FMath::Min(FrameBudget, MaxFrameTimeBudget);
+        const double StreamingStartTime = FPlatformTime::Seconds();
+        TickStreaming(SpawnQueueBudget * 0.5);
+
+        const double StreamingTime = FPlatformTime::Seconds() - StreamingStartTime;
+        TickSpawnQueue(FMath::Max(SpawnQueueBudget - StreamingTime, SpawnQueueBudget * 0.5));
+
+        // Both slices are this manager's work when the next budget is computed
+        LastLoadSliceTime = FPlatformTime::Seconds() - StreamingStartTime;
+        return;
+    }
+
+    // Only the current level's block is ever visited
+    const TArray<FSavedItemCompact>& LevelItems = CachedSaveGame->Levels[CachedLevelIndex].Items;
+    int32 TotalItems = LevelItems.Num();
+
+    if (TotalItems == 0)
+    {
+        bIsLoading = false;
+        OnLoadingCompleted();
+        SetActorTickEnabled(false);
+        return;
+    }
+
+    UpdateLoadPriority();
+
+    const double FrameBudget = ComputeLoadFrameBudget(DeltaTime);
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 StartIndex = CurrentLoadIndex;
+    const int32 ItemsPerClockCheck = GetItemsPerClockCheck(FrameBudget);
+
+    // --- TIME-SLICED LOOP ---
+    int32 ItemsUntilClockCheck = 0;
+    while (CurrentLoadIndex < TotalItems)
+    {
+        // Check frame budget
+        if (ItemsUntilClockCheck-- <= 0)
+        {
+            if ((FPlatformTime::Seconds() - StartTime) > FrameBudget)
+            {
+                break;
+            }
+            ItemsUntilClockCheck = ItemsPerClockCheck - 1;
+        }
+
+        // Spawn (reuses a pooled actor when one is available)
+        SpawnSavedItem(LevelItems[NextLoadItemIndex()], LoadPhysicsMode != ESandboxLoadPhysicsMode::Immediate);
+
+        CurrentLoadIndex++;
+    }
+
+    // Feed the measured slice back into the budget controller
+    RecordLoadSlice(FPlatformTime::Seconds() - StartTime, CurrentLoadIndex - StartIndex);
+
+    // Report Progress (preload phase occupies the first PreloadProgressWeight share)
+    float SpawnPercent = (TotalItems > 0) ? (float)CurrentLoadIndex / (float)TotalItems : 1.0f;
+    OnLoadingProgress(PreloadProgressWeight + SpawnPercent * (1.0f - PreloadProgressWeight));
+
+    // Completion
+    if (CurrentLoadIndex >= TotalItems)
+    {
+        CompleteLoading();
+    }
+}
+
+AActor* ASandboxWorldManager::SpawnSavedItem(const FSavedItemCompact& ItemData, bool bHoldPhysics)
+{
+    // Assets were streamed in during the preload phase, no blocking loads here
+    UClass** FoundClass = ClassCache.Find(ItemData.PaletteIndex);
+    USandboxItemData** FoundData = DataAssetCache.Find(ItemData.PaletteIndex);
+
+    if (FoundClass && FoundData && *FoundClass && *FoundData)
+    {
+        return AcquireItemActor(*FoundClass, *FoundData, ItemData.Transform, ItemData.ItemId, bHoldPhysics, &ItemData.Physics);
+    }
+    return nullptr;
+}
+
+void ASandboxWorldManager::CompleteLoading()
+{
+    bIsLoading = false;
+    LoadCells.Empty();
+    ReleaseHeldPhysics();
+    FinishLoadTracking();
+
+    // Streaming keeps spawning later, the caches and preloaded assets stay resident
+    if (!bStreamingActive)
+    {
+        CachedSaveGame = nullptr;
+        ClassCache.Empty();
+        DataAssetCache.Empty();
+
+        // Spawned actors and identity components now hold their own references
+        DataAssetPreloadHandle.Reset();
+        ClassPreloadHandle.Reset();
+
+        SetActorTickEnabled(false);
+    }
+
+    OnLoadingCompleted();
+
+    if (GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Green, TEXT("Async Load Completed!"));
+    }
+
+    // Saves requested during loading were deferred
+    if (bSaveQueued)
+    {
+        bSaveQueued = false;
+        SaveWorld();
+    }
+}
+
+double ASandboxWorldManager::ComputeLoadFrameBudget(float DeltaTime)
+{
+    const double TargetFrameTime = 1.0 / FMath::Max(TargetFrameRate, 1.0f);
+
+    // DeltaTime includes last frame's load slice
+    SmoothedFrameTime = (SmoothedFrameTime > 0.0) ? FMath::Lerp(SmoothedFrameTime, (double)DeltaTime, 0.1) : (double)DeltaTime;
+
+    switch (LoadBudgetMode)
+    {
+    case ESandboxLoadBudgetMode::LoadingScreen:
+        // Nothing else competes for the frame, take most of it
+        return TargetFrameTime * LoadingScreenBudgetFraction;
+
+    case ESandboxLoadBudgetMode::Background:
+    {
+        // Whatever the rest of the frame leaves before the target is missed
+        const double OtherWork = FMath::Max(SmoothedFrameTime - LastLoadSliceTime, 0.0);
+        return FMath::Clamp(TargetFrameTime - OtherWork, MinFrameTimeBudget, FMath::Max(MaxFrameTimeBudget, MinFrameTimeBudget));
+    }
+
+    case ESandboxLoadBudgetMode::Fixed:
+    default:
+        return MaxFrameTimeBudget;
+    }
+}
+
+int32 ASandboxWorldManager::GetItemsPerClockCheck(double FrameBudget) const
+{
+    // OPTIMIZATION: Read the clock every N items, N sized so a batch stays around 1/8 of the budget
+    if (SmoothedItemCost <= 0.0) return 1;
+    return FMath::Clamp(FMath::FloorToInt32((FrameBudget * 0.125) / SmoothedItemCost), 1, MaxItemsPerClockCheck);
+}
+
+void ASandboxWorldManager::RecordLoadSlice(double Elapsed, int32 ItemsSpawned)
+{
+    LastLoadSliceTime = Elapsed;
+    if (ItemsSpawned > 0)
+    {
+        const double ItemCost = Elapsed / ItemsSpawned;
+        SmoothedItemCost = (SmoothedItemCost > 0.0) ? FMath::Lerp(SmoothedItemCost, ItemCost, 0.2) : ItemCost;
+    }
+}
+
+// =========================================================================
+// LOAD ORDER
+// =========================================================================
+
+void ASandboxWorldManager::LoadWorldAround(FVector FocusLocation)
+{
+    // Consumed by the next (possibly queued) LoadWorld
+    bHasLoadFocusOverride = true;
+    LoadFocusOverride = FocusLocation;
+
+    LoadWorld();
+}
+
+FVector ASandboxWorldManager::GetLoadFocusLocation() const
+{
+    if (APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0))
+    {
+        return PlayerPawn->GetActorLocation();
+    }
+
+    return CachedSaveGame ? CachedSaveGame->PlayerTransform.GetLocation() : GetActorLocation();
+}
+
+void ASandboxWorldManager::BuildLoadCells(const TArray<FSavedItemCompact>& LevelItems)
+{
+    LoadCells.Reset();
+    CurrentLoadCell = 0;
+
+    LastLoadFocus = bHasLoadFocusOverride ? LoadFocusOverride : GetLoadFocusLocation();
+    bHasLoadFocusOverride = false;
+
+    if (!bPrioritizeLoadByDistance) return;
+
+    // Bucket by XY cell, levels are mostly flat
+    const double CellSize = FMath::Max(LoadCellSize, 100.0f);
+    TMap<FIntPoint, int32> CellIndexByCoord;
+    for (int32 ItemIndex = 0; ItemIndex < LevelItems.Num(); ++ItemIndex)
+    {
+        const FVector Location = LevelItems[ItemIndex].Transform.GetLocation();
+        const FIntPoint Coord(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+
+        int32& CellIndex = CellIndexByCoord.FindOrAdd(Coord, INDEX_NONE);
+        if (CellIndex == INDEX_NONE)
+        {
+            CellIndex = LoadCells.AddDefaulted();
+            LoadCells[CellIndex].Center = FVector((Coord.X + 0.5) * CellSize, (Coord.Y + 0.5) * CellSize, 0.0);
+        }
+
+        LoadCells[CellIndex].ItemIndices.Add(ItemIndex);
+    }
+
+    // Cell centers carry no height, compare against the focus on the same plane
+    const FVector Focus(LastLoadFocus.X, LastLoadFocus.Y, 0.0);
+    LoadCells.Sort([&Focus](const FLoadCell& A, const FLoadCell& B)
+        {
+            return FVector::DistSquared(A.Center, Focus) < FVector::DistSquared(B.Center, Focus);
+        });
+}
+
+void ASandboxWorldManager::UpdateLoadPriority()
+{
+    if (LoadCells.Num() - CurrentLoadCell < 2) return;
+
+    const FVector FocusLocation = GetLoadFocusLocation();
+    if (FVector::DistSquared2D(FocusLocation, LastLoadFocus) < FMath::Square(LoadReprioritizeDistance)) return;
+
+    LastLoadFocus = FocusLocation;
+
+    // Only the undrained tail is re-sorted; the partially spawned cell may move back
+    const FVector Focus(FocusLocation.X, FocusLocation.Y, 0.0);
+    TArrayView<FLoadCell> Remaining = MakeArrayView(LoadCells).Slice(CurrentLoadCell, LoadCells.Num() - CurrentLoadCell);
+    Algo::Sort(Remaining, [&Focus](const FLoadCell& A, const FLoadCell& B)
+        {
+            return FVector::DistSquared(A.Center, Focus) < FVector::DistSquared(B.Center, Focus);
+        });
+}
+
+int32 ASandboxWorldManager::NextLoadItemIndex()
+{
+    // Unprioritized: raw array order
+    if (LoadCells.Num() == 0) return CurrentLoadIndex;
+
+    while (LoadCells.IsValidIndex(CurrentLoadCell) && LoadCells[CurrentLoadCell].NextItem >= LoadCells[CurrentLoadCell].ItemIndices.Num())
+    {
+        CurrentLoadCell++;
+    }
+
+    FLoadCell& Cell = LoadCells[CurrentLoadCell];
+    return Cell.ItemIndices[Cell.NextItem++];
+}
+
+// =========================================================================
+// CELL STREAMING
+// =========================================================================
+
+FIntPoint ASandboxWorldManager::GetStreamingCell(const FVector& Location) const
+{
+    const double CellSize = FMath::Max(StreamingCellSize, 100.0f);
+    return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+double ASandboxWorldManager::GetStreamingCellDistance(const FIntPoint& Cell, const FVector& Location) const
+{
+    // Distance to the nearest point of the cell, so large cells load before the player reaches their center
+    const double CellSize = FMath::Max(StreamingCellSize, 100.0f);
+    const FBox2D Bounds(FVector2D(Cell.X * CellSize, Cell.Y * CellSize), FVector2D((Cell.X + 1) * CellSize, (Cell.Y + 1) * CellSize));
+    return FMath::Sqrt(Bounds.ComputeSquaredDistanceToPoint(FVector2D(Location.X, Location.Y)));
+}
+
+void ASandboxWorldManager::StartStreaming()
+{
+    StopStreaming();
+
+    FSavedLevelData& Level = CachedSaveGame->Levels[CachedLevelIndex];
+    StreamedLevelName = Level.LevelName;
+
+    SavedCellByItemId.Reserve(Level.Items.Num());
+    for (const FSavedItemCompact& Item : Level.Items)
+    {
+        IndexStreamedItem(Item.ItemId, GetStreamingCell(Item.Transform.GetLocation()));
+    }
+
+    bStreamingActive = true;
+
+    // The first cell set is built around the load focus, later ones follow the player
+    const FVector Focus = bHasLoadFocusOverride ? LoadFocusOverride : GetLoadFocusLocation();
+    UpdateStreamedCells(Focus, true);
+    StreamInitialQueueCount = StreamSpawnQueue.Num();
+}
+
+void ASandboxWorldManager::StopStreaming()
+{
+    bStreamingActive = false;
+    StreamedCells.Reset();
+    SavedItemIdsByCell.Reset();
+    SavedCellByItemId.Reset();
+    StreamedLiveIds.Reset();
+    StreamSpawnQueue.Reset();
+    StreamSpawnCursor = 0;
+    StreamInitialQueueCount = 0;
+
+    for (TPair<int32, TSharedPtr<FStreamableHandle>>& Entry : PaletteLoadHandles)
+    {
+        if (Entry.Value.IsValid())
+        {
+            Entry.Value->CancelHandle();
+        }
+    }
+    PaletteLoadHandles.Reset();
+    DeferredStreamIds.Reset();
+}
+
+void ASandboxWorldManager::IndexStreamedItem(int32 ItemId, const FIntPoint& Cell)
+{
+    if (FIntPoint* PreviousCell = SavedCellByItemId.Find(ItemId))
+    {
+        if (*PreviousCell == Cell) return;
+
+        if (TArray<int32>* PreviousIds = SavedItemIdsByCell.Find(*PreviousCell))
+        {
+            PreviousIds->RemoveSwap(ItemId, EAllowShrinking::No);
+        }
+    }
+
+    SavedCellByItemId.Add(ItemId, Cell);
+    SavedItemIdsByCell.FindOrAdd(Cell).Add(ItemId);
+}
+
+void ASandboxWorldManager::UpdateStreamedCells(const FVector& Focus, bool bForce)
+{
+    const double CellSize = FMath::Max(StreamingCellSize, 100.0f);
+
+    // Cell membership can't change before the player covers a fraction of a cell
+    if (!bForce && FVector::DistSquared2D(Focus, LastStreamingFocus) < FMath::Square(CellSize * 0.25)) return;
+    LastStreamingFocus = Focus;
+
+    // --- UNLOAD (beyond radius + hysteresis) ---
+    const double UnloadDistance = StreamingRadius + StreamingHysteresis;
+    for (auto It = StreamedCells.CreateIterator(); It; ++It)
+    {
+        if (GetStreamingCellDistance(*It, Focus) > UnloadDistance)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    StreamOutItems();
+
+    // --- LOAD (within radius, nearest first) ---
+    const FIntPoint Center = GetStreamingCell(Focus);
+    const int32 Reach = FMath::CeilToInt32(StreamingRadius / CellSize) + 1;
+
+    TArray<FIntPoint> NewCells;
+    for (int32 Y = Center.Y - Reach; Y <= Center.Y + Reach; ++Y)
+    {
+        for (int32 X = Center.X - Reach; X <= Center.X + Reach; ++X)
+        {
+            const FIntPoint Cell(X, Y);
+            if (!StreamedCells.Contains(Cell) && GetStreamingCellDistance(Cell, Focus) <= StreamingRadius)
+            {
+                NewCells.Add(Cell);
+            }
+        }
+    }
+
+    NewCells.Sort([this, &Focus](const FIntPoint& A, const FIntPoint& B)
+        {
+            return GetStreamingCellDistance(A, Focus) < GetStreamingCellDistance(B, Focus);
+        });
+
+    for (const FIntPoint& Cell : NewCells)
+    {
+        StreamedCells.Add(Cell);
+
+        if (const TArray<int32>* ItemIds = SavedItemIdsByCell.Find(Cell))
+        {
+            for (int32 ItemId : *ItemIds)
+            {
+                // Items carried here from another cell are already alive
+                bool bAlreadyLive = false;
+                StreamedLiveIds.Add(ItemId, &bAlreadyLive);
+                if (!bAlreadyLive)
+                {
+                    StreamSpawnQueue.Add(ItemId);
+                }
+            }
+        }
+    }
+}
+
+void ASandboxWorldManager::StreamOutItems()
+{
+    USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this);
+    if (!Registry || !CachedSaveGame->Levels.IsValidIndex(CachedLevelIndex)) return;
+
+    FSavedLevelData& Level = CachedSaveGame->Levels[CachedLevelIndex];
+
+    // Every live item is checked by its current position, covering items carried or knocked out of range
+    TArray<USandboxIdentityComponent*> Leaving;
+    for (USandboxIdentityComponent* Identity : Registry->GetItems())
+    {
+        AActor* Actor = Identity ? Identity->GetOwner() : nullptr;
+        if (IsValid(Actor) && Identity->SourceItemData && !StreamedCells.Contains(GetStreamingCell(Actor->GetActorLocation())))
+        {
+            Leaving.Add(Identity);
+        }
+    }
+
+    for (USandboxIdentityComponent* Identity : Leaving)
+    {
+        AActor* Actor = Identity->GetOwner();
+
+        if (Identity->ItemId == 0)
+        {
+            Identity->ItemId = Level.NextItemId++;
+        }
+
+        FSavedItemCompact CompactItem;
+        CompactItem.PaletteIndex = ResolvePaletteIndex(Identity->SourceItemData);
+        CompactItem.ItemId = Identity->ItemId;
+        CaptureItemState(Actor, CompactItem);
+        WriteBackStreamedItem(Level, CompactItem);
+
+        PoolItemActor(Actor, false);
+    }
+
+    // Instanced items leave their batch the same way (backwards, removal may swap the last instance in)
+    for (TPair<TObjectPtr<USandboxItemData>, FSandboxInstanceBatch>& Entry : InstanceBatches)
+    {
+        FSandboxInstanceBatch& Batch = Entry.Value;
+        for (int32 InstanceIndex = Batch.Items.Num() - 1; InstanceIndex >= 0; --InstanceIndex)
+        {
+            const FSandboxInstancedItem& Item = Batch.Items[InstanceIndex];
+            if (StreamedCells.Contains(GetStreamingCell(Item.ActorTransform.GetLocation()))) continue;
+
+            FSavedItemCompact CompactItem;
+            CompactItem.PaletteIndex = ResolvePaletteIndex(Entry.Key);
+            CompactItem.ItemId = Item.ItemId;
+            CompactItem.Transform = Item.ActorTransform;
+            CompactItem.Physics.bAsleep = true;
+            WriteBackStreamedItem(Level, CompactItem);
+
+            RemoveInstanceAt(Batch, InstanceIndex);
+        }
+    }
+}
+
+void ASandboxWorldManager::WriteBackStreamedItem(FSavedLevelData& Level, const FSavedItemCompact& Item)
+{
+    // --- WRITE-BACK ---
+    // The working save (and the journal, so incremental saves stay complete) holds the item from now on
+    Level.UpsertItem(Item);
+    if (WorkingJournal)
+    {
+        WorkingJournal->RecordUpsert(StreamedLevelName, Item);
+    }
+
+    // The snapshot being encoded was captured before this, it replaces the block when it commits
+    if (SaveStage == ESaveStage::Encoding)
+    {
+        EncodingWriteBacks.Add(Item.ItemId, Item);
+    }
+
+    IndexStreamedItem(Item.ItemId, GetStreamingCell(Item.Transform.GetLocation()));
+    StreamedLiveIds.Remove(Item.ItemId);
+}
+
+void ASandboxWorldManager::TickStreaming(double FrameBudget)
+{
+    // The initial cell set is kept until it has loaded
+    if (!bIsLoading)
+    {
+        UpdateStreamedCells(GetLoadFocusLocation(), false);
+    }
+
+    FSavedLevelData& Level = CachedSaveGame->Levels[CachedLevelIndex];
+    USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this);
+    const bool bHoldPhysics = bIsLoading && LoadPhysicsMode != ESandboxLoadPhysicsMode::Immediate;
+
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 StartCursor = StreamSpawnCursor;
+    const int32 ItemsPerClockCheck = GetItemsPerClockCheck(FrameBudget);
+
+    // --- TIME-SLICED LOOP ---
+    int32 ItemsUntilClockCheck = 0;
+    while (StreamSpawnCursor < StreamSpawnQueue.Num())
+    {
+        if (ItemsUntilClockCheck-- <= 0)
+        {
+            if ((FPlatformTime::Seconds() - StartTime) > FrameBudget)
+            {
+                break;
+            }
+            ItemsUntilClockCheck = ItemsPerClockCheck - 1;
+        }
+
+        const int32 ItemId = StreamSpawnQueue[StreamSpawnCursor++];
+
+        // Removed since it was queued, or its cell unloaded before its turn came
+        const FSavedItemCompact* SavedItem = Level.FindItem(ItemId);
+        const FIntPoint* SavedCell = SavedCellByItemId.Find(ItemId);
+        if (!SavedItem || !SavedCell || !StreamedCells.Contains(*SavedCell))
+        {
+            StreamedLiveIds.Remove(ItemId);
+            continue;
+        }
+
+        // Streaming can meet palette entries added after the preload (items placed during play)
+        if (!ClassCache.Contains(SavedItem->PaletteIndex) && CachedSaveGame->AssetPalette.IsValidIndex(SavedItem->PaletteIndex))
+        {
+            DeferredStreamIds.FindOrAdd(SavedItem->PaletteIndex).Add(ItemId);
+            RequestPaletteEntry(SavedItem->PaletteIndex);
+            continue;
+        }
+
+        AActor* Actor = SpawnSavedItem(*SavedItem, bHoldPhysics);
+
+        // Streamed in exactly as saved, nothing to write until it changes
+        USandboxIdentityComponent* Identity = Actor ? Actor->FindComponentByClass<USandboxIdentityComponent>() : nullptr;
+        if (Identity && Registry)
+        {
+            Registry->ClearDirty(Identity);
+        }
+    }
+
+    RecordLoadSlice(FPlatformTime::Seconds() - StartTime, StreamSpawnCursor - StartCursor);
+
+    if (StreamSpawnCursor >= StreamSpawnQueue.Num())
+    {
+        StreamSpawnQueue.Reset();
+        StreamSpawnCursor = 0;
+    }
+
+    if (bIsLoading)
+    {
+        const int32 Remaining = StreamSpawnQueue.Num() - StreamSpawnCursor;
+        const float SpawnPercent = (StreamInitialQueueCount > 0) ? 1.0f - (float)Remaining / (float)StreamInitialQueueCount : 1.0f;
+        OnLoadingProgress(PreloadProgressWeight + SpawnPercent * (1.0f - PreloadProgressWeight));
+
+        if (Remaining == 0)
+        {
+            CompleteLoading();
+        }
+    }
+}
+
+void ASandboxWorldManager::RequestPaletteEntry(int32 PaletteIndex)
+{
+    if (PaletteLoadHandles.Contains(PaletteIndex)) return;
+
+    // Marks the entry as in flight, the delegate can run before the request returns
+    PaletteLoadHandles.Add(PaletteIndex);
+
+    // OPTIMIZATION: Never a blocking load inside the time-sliced loop, the items wait in DeferredStreamIds
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        FSoftObjectPath(CachedSaveGame->AssetPalette[PaletteIndex]),
+        FStreamableDelegate::CreateUObject(this, &ASandboxWorldManager::OnPaletteDataLoaded, PaletteIndex)
+    );
+
+    if (!Handle.IsValid())
+    {
+        OnPaletteDataLoaded(PaletteIndex);
+        return;
+    }
+
+    TSharedPtr<FStreamableHandle>* Pending = PaletteLoadHandles.Find(PaletteIndex);
+    if (Pending && !Pending->IsValid())
+    {
+        *Pending = Handle;
+    }
+}
+
+void ASandboxWorldManager::OnPaletteDataLoaded(int32 PaletteIndex)
+{
+    if (!CachedSaveGame || !PaletteLoadHandles.Contains(PaletteIndex)) return;
+
+    USandboxItemData* SourceData = Cast<USandboxItemData>(FSoftObjectPath(CachedSaveGame->AssetPalette[PaletteIndex]).ResolveObject());
+    DataAssetCache.Add(PaletteIndex, SourceData);
+
+    if (!SourceData || SourceData->ActorClassToSpawn.IsNull())
+    {
+        OnPaletteClassLoaded(PaletteIndex);
+        return;
+    }
+
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        SourceData->ActorClassToSpawn.ToSoftObjectPath(),
+        FStreamableDelegate::CreateUObject(this, &ASandboxWorldManager::OnPaletteClassLoaded, PaletteIndex)
+    );
+
+    if (!Handle.IsValid())
+    {
+        OnPaletteClassLoaded(PaletteIndex);
+        return;
+    }
+
+    if (TSharedPtr<FStreamableHandle>* Pending = PaletteLoadHandles.Find(PaletteIndex))
+    {
+        *Pending = Handle;
+    }
+}
+
+void ASandboxWorldManager::OnPaletteClassLoaded(int32 PaletteIndex)
+{
+    if (!PaletteLoadHandles.Remove(PaletteIndex)) return;
+
+    // A failed load is cached as null, its items are skipped instead of requested again
+    USandboxItemData** FoundData = DataAssetCache.Find(PaletteIndex);
+    ClassCache.Add(PaletteIndex, (FoundData && *FoundData) ? (*FoundData)->ActorClassToSpawn.Get() : nullptr);
+
+    // Back into the queue; a cell unloaded meanwhile drops them there
+    TArray<int32> ItemIds;
+    if (DeferredStreamIds.RemoveAndCopyValue(PaletteIndex, ItemIds))
+    {
+        StreamSpawnQueue.Append(ItemIds);
+    }
+}
+
+// =========================================================================
+// ACTOR POOL
+// =========================================================================
+
+AActor* ASandboxWorldManager::SpawnItem(USandboxItemData* ItemData, const FTransform& Transform)
+{
+    if (!ItemData || ItemData->ActorClassToSpawn.IsNull()) return nullptr;
+
+    UClass* ActorClass = ItemData->ActorClassToSpawn.LoadSynchronous();
+    if (!ActorClass) return nullptr;
+
+    return AcquireItemActor(ActorClass, ItemData, Transform, 0, false);
+}
+
+AActor* ASandboxWorldManager::AcquireItemActor(UClass* ActorClass, USandboxItemData* ItemData, const FTransform& Transform, int32 ItemId, bool bHoldPhysics, const FSavedPhysicsState* SavedPhysics)
+{
+    UWorld* World = GetWorld();
+    if (!World || !ActorClass || !ItemData) return nullptr;
+
+    AActor* Actor = nullptr;
+
+    // 1. Reuse a pooled actor: only a transform update and a state reset
+    if (FSandboxActorPoolBucket* Bucket = ActorPool.Find(ActorClass))
+    {
+        while (Bucket->Actors.Num() > 0 && !Actor)
+        {
+            AActor* Candidate = Bucket->Actors.Pop(EAllowShrinking::No);
+            PooledActorCount = FMath::Max(0, PooledActorCount - 1);
+            if (IsValid(Candidate))
+            {
+                Actor = Candidate;
+            }
+        }
+    }
+
+    if (Actor)
+    {
+        PoolHits++;
+
+        // Disabled mode creates the bodies later, in ReleaseHeldPhysics
+        const bool bEnableCollision = !bHoldPhysics || LoadPhysicsMode != ESandboxLoadPhysicsMode::Disabled;
+        ReactivatePooledActor(Actor, Transform, bEnableCollision);
+
+        USandboxIdentityComponent* Identity = Actor->FindComponentByClass<USandboxIdentityComponent>();
+        if (!Identity)
+        {
+            Identity = NewObject<USandboxIdentityComponent>(Actor);
+            Identity->RegisterComponent();
+        }
+
+        InitializeItemIdentity(Identity, ItemData, ItemId);
+
+        // Pooled identities were taken out of the registry on release
+        if (USandboxItemRegistry* Registry = World->GetSubsystem<USandboxItemRegistry>())
+        {
+            Registry->RegisterItem(Identity);
+        }
+    }
+    else
+    {
+        // 2. Pool miss: full spawn
+        PoolMisses++;
+
+        if (bDeferredSpawning)
+        {
+            Actor = SpawnItemActorDeferred(ActorClass, ItemData, Transform, ItemId, bHoldPhysics);
+        }
+        else
+        {
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+            Actor = World->SpawnActor<AActor>(ActorClass, Transform, SpawnParams);
+            if (Actor)
+            {
+                USandboxIdentityComponent* Identity = Actor->FindComponentByClass<USandboxIdentityComponent>();
+                if (!Identity)
+                {
+                    Identity = NewObject<USandboxIdentityComponent>(Actor);
+                    Identity->RegisterComponent();
+                }
+
+                InitializeItemIdentity(Identity, ItemData, ItemId);
+
+                if (bHoldPhysics && LoadPhysicsMode == ESandboxLoadPhysicsMode::Disabled)
+                {
+                    Actor->SetActorEnableCollision(false);
+                }
+            }
+        }
+
+        if (!Actor) return nullptr;
+    }
+
+    if (bHoldPhysics)
+    {
+        if (LoadPhysicsMode == ESandboxLoadPhysicsMode::Asleep)
+        {
+            TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+            for (UPrimitiveComponent* Primitive : Primitives)
+            {
+                if (Primitive->IsSimulatingPhysics())
+                {
+                    Primitive->PutAllRigidBodiesToSleep();
+                }
+            }
+        }
+
+        HeldPhysicsActors.Add(Actor);
+        HeldPhysicsStates.Add(SavedPhysics ? *SavedPhysics : FSavedPhysicsState());
+    }
+    else
+    {
+        if (SavedPhysics && bRestorePhysicsState)
+        {
+            ApplyPhysicsState(Actor, *SavedPhysics);
+        }
+
+        // Settled items get frozen instead of simulating indefinitely
+        if (USandboxPhysicsSleepSubsystem* SleepSubsystem = USandboxPhysicsSleepSubsystem::Get(this))
+        {
+            SleepSubsystem->WatchActor(Actor);
+        }
+    }
+
+    return Actor;
+}
+
+AActor* ASandboxWorldManager::SpawnItemActorDeferred(UClass* ActorClass, USandboxItemData* ItemData, const FTransform& Transform, int32 ItemId, bool bHoldPhysics)
+{
+    AActor* Actor = GetWorld()->SpawnActorDeferred<AActor>(ActorClass, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+    if (!Actor) return nullptr;
+
+    // Construction scripts create their primitives with collision off, bodies are built in ReleaseHeldPhysics
+    if (bHoldPhysics && LoadPhysicsMode == ESandboxLoadPhysicsMode::Disabled)
+    {
+        Actor->SetActorEnableCollision(false);
+    }
+
+    // Native identity components already exist, fill them before construction and BeginPlay see them
+    USandboxIdentityComponent* Identity = Actor->FindComponentByClass<USandboxIdentityComponent>();
+
+    // Classes without one get it added up front instead of after a full spawn
+    const bool* bProvidesIdentity = ClassProvidesIdentity.Find(ActorClass);
+    if (!Identity && bProvidesIdentity && !*bProvidesIdentity)
+    {
+        Identity = NewObject<USandboxIdentityComponent>(Actor);
+        Actor->AddInstanceComponent(Identity);
+        Identity->RegisterComponent();
+    }
+
+    if (Identity)
+    {
+        InitializeItemIdentity(Identity, ItemData, ItemId);
+    }
+
+    Actor->FinishSpawning(Transform);
+
+    if (!Identity)
+    {
+        // First spawn of this class: learn whether its construction script adds an identity
+        Identity = Actor->FindComponentByClass<USandboxIdentityComponent>();
+        ClassProvidesIdentity.Add(ActorClass, Identity != nullptr);
+
+        if (!Identity)
+        {
+            Identity = NewObject<USandboxIdentityComponent>(Actor);
+            Actor->AddInstanceComponent(Identity);
+            Identity->RegisterComponent();
+        }
+
+        InitializeItemIdentity(Identity, ItemData, ItemId);
+    }
+
+    return Actor;
 }
 
-void ASandboxWorldManager::SaveWorld()
+void ASandboxWorldManager::InitializeItemIdentity(USandboxIdentityComponent* Identity, USandboxItemData* ItemData, int32 ItemId)
 {
-    UWorld* World = GetWorld();
-    if (!World) return;
+    Identity->SourceItemData = ItemData;
+    Identity->CurrentHealth = ItemData->DefaultHealth;
+    Identity->ItemId = ItemId;
+}
 
-    FString CurrentLevelName = UGameplayStatics::GetCurrentLevelName(this);
+void ASandboxWorldManager::ReleaseHeldPhysics()
+{
+    USandboxPhysicsSleepSubsystem* SleepSubsystem = USandboxPhysicsSleepSubsystem::Get(this);
 
-    // 1. Try to load existing save to preserve data from other levels
-    USandboxSaveGame* SaveInst = nullptr;
-    if (UGameplayStatics::DoesSaveGameExist(SaveSlotName, 0))
+    // One pass at the end of the batch instead of bodies entering the scene item by item
+    for (int32 HeldIndex = 0; HeldIndex < HeldPhysicsActors.Num(); ++HeldIndex)
+    {
+        AActor* Actor = HeldPhysicsActors[HeldIndex];
+        if (!IsValid(Actor) || Actor->IsHidden()) continue;
+
+        const FSavedPhysicsState& SavedPhysics = HeldPhysicsStates[HeldIndex];
+        const bool bRestoreAsleep = bRestorePhysicsState && SavedPhysics.bAsleep;
+
+        if (!Actor->GetActorEnableCollision())
+        {
+            // Bodies are created awake here
+            Actor->SetActorEnableCollision(true);
+        }
+        else if (!bRestoreAsleep)
+        {
+            TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+            for (UPrimitiveComponent* Primitive : Primitives)
+            {
+                if (Primitive->IsSimulatingPhysics())
+                {
+                    Primitive->WakeAllRigidBodies();
+                }
+            }
+        }
+
+        // Items saved asleep stay asleep, so the solver only sees what was moving at save time
+        if (bRestorePhysicsState)
+        {
+            ApplyPhysicsState(Actor, SavedPhysics);
+        }
+
+        // Loaded stacks settle once, then leave the solver
+        if (SleepSubsystem)
+        {
+            SleepSubsystem->WatchActor(Actor);
+        }
+    }
+
+    HeldPhysicsActors.Reset();
+    HeldPhysicsStates.Reset();
+}
+
+void ASandboxWorldManager::CaptureItemState(const AActor* Actor, FSavedItemCompact& OutItem) const
+{
+    OutItem.Transform = Actor->GetActorTransform();
+    OutItem.Physics = FSavedPhysicsState();
+
+    if (!bSavePhysicsState) return;
+
+    const UPrimitiveComponent* Root = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+    if (!Root) return;
+
+    if (!Root->IsSimulatingPhysics())
     {
-        SaveInst = Cast<USandboxSaveGame>(UGameplayStatics::LoadGameFromSlot(SaveSlotName, 0));
+        // Kinematic-frozen items are settled as far as the next load is concerned
+        const USandboxPhysicsSleepSubsystem* SleepSubsystem = USandboxPhysicsSleepSubsystem::Get(this);
+        OutItem.Physics.bAsleep = SleepSubsystem && SleepSubsystem->IsFrozen(Root);
+        return;
     }
 
-    // Create new if invalid
-    if (!SaveInst)
+    if (!Root->RigidBodyIsAwake())
     {
-        SaveInst = Cast<USandboxSaveGame>(UGameplayStatics::CreateSaveGameObject(USandboxSaveGame::StaticClass()));
+        OutItem.Physics.bAsleep = true;
+        return;
     }
 
-    if (!SaveInst) return;
+    OutItem.Physics.LinearVelocity = FVector3f(Root->GetPhysicsLinearVelocity());
+    OutItem.Physics.AngularVelocity = FVector3f(Root->GetPhysicsAngularVelocityInDegrees());
+}
 
-    // --- CLEANUP ---
-    // Remove items belonging to the current level before rewriting
-    SaveInst->Items.RemoveAll([&CurrentLevelName](const FSavedItemCompact& Item)
-        {
-            return Item.LevelName == CurrentLevelName;
-        });
+void ASandboxWorldManager::ApplyPhysicsState(AActor* Actor, const FSavedPhysicsState& Physics) const
+{
+    UPrimitiveComponent* Root = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+    if (!Root || !Root->IsSimulatingPhysics()) return;
 
-    // --- COLLECTION ---
-    // Reconstruct palette lookup
-    TMap<FString, int32> PaletteLookup;
-    for (int32 i = 0; i < SaveInst->AssetPalette.Num(); i++)
+    if (Physics.bAsleep)
     {
-        PaletteLookup.Add(SaveInst->AssetPalette[i], i);
+        Root->PutAllRigidBodiesToSleep();
+        return;
     }
 
-    for (TActorIterator<AActor> It(World); It; ++It)
+    if (Physics.HasVelocity())
     {
-        AActor* Actor = *It;
-        if (!IsValid(Actor)) continue;
+        Root->SetPhysicsLinearVelocity(FVector(Physics.LinearVelocity));
+        Root->SetPhysicsAngularVelocityInDegrees(FVector(Physics.AngularVelocity));
+    }
+}
 
-        // Only save actors with Identity component
-        USandboxIdentityComponent* Identity = Actor->FindComponentByClass<USandboxIdentityComponent>();
+void ASandboxWorldManager::ReleaseItem(AActor* Actor)
+{
+    PoolItemActor(Actor, true);
+}
+
+void ASandboxWorldManager::PoolItemActor(AActor* Actor, bool bRemoveFromSave)
+{
+    if (!IsValid(Actor)) return;
 
-        if (Identity && Identity->SourceItemData)
+    USandboxIdentityComponent* Identity = Actor->FindComponentByClass<USandboxIdentityComponent>();
+
+    FSandboxActorPoolBucket& Bucket = ActorPool.FindOrAdd(Actor->GetClass());
+    const bool bPoolHasRoom = bUseActorPool
+        && Bucket.Actors.Num() < MaxPooledActorsPerClass
+        && PooledActorCount < MaxPooledActorsTotal;
+
+    if (!bPoolHasRoom)
+    {
+        // EndPlay reports the removal to the registry, unless the item lives on in the save
+        if (Identity && !bRemoveFromSave)
         {
-            FString AssetPath = Identity->SourceItemData->GetPathName();
-            int32 PaletteIndex = -1;
+            Identity->ItemId = 0;
+        }
+        Actor->Destroy();
+        return;
+    }
 
-            if (int32* FoundIdx = PaletteLookup.Find(AssetPath))
-            {
-                PaletteIndex = *FoundIdx;
-            }
-            else
+    if (Identity)
+    {
+        if (USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this))
+        {
+            if (bRemoveFromSave)
             {
-                PaletteIndex = SaveInst->AssetPalette.Add(AssetPath);
-                PaletteLookup.Add(AssetPath, PaletteIndex);
+                Registry->NotifyItemDestroyed(Identity);
             }
+            Registry->UnregisterItem(Identity);
+        }
 
-            FSavedItemCompact CompactItem;
-            CompactItem.PaletteIndex = PaletteIndex;
-            CompactItem.Transform = Actor->GetActorTransform();
-            CompactItem.LevelName = CurrentLevelName;
+        Identity->SourceItemData = nullptr;
+        Identity->ItemId = 0;
+    }
 
-            SaveInst->Items.Add(CompactItem);
-        }
+    DeactivatePooledActor(Actor);
+    Bucket.Actors.Add(Actor);
+    PooledActorCount++;
+}
+
+void ASandboxWorldManager::DeactivatePooledActor(AActor* Actor)
+{
+    if (USandboxPhysicsSleepSubsystem* SleepSubsystem = USandboxPhysicsSleepSubsystem::Get(this))
+    {
+        SleepSubsystem->ForgetActor(Actor);
     }
 
-    UGameplayStatics::SaveGameToSlot(SaveInst, SaveSlotName, 0);
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
 
-    if (GEngine)
+    TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+    for (UPrimitiveComponent* Primitive : Primitives)
     {
-        GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Green, FString::Printf(TEXT("Saved items for level: %s"), *CurrentLevelName));
+        if (Primitive->IsSimulatingPhysics())
+        {
+            Primitive->SetSimulatePhysics(false);
+        }
+        Primitive->SetComponentTickEnabled(false);
     }
 }
 
-void ASandboxWorldManager::LoadWorld()
+void ASandboxWorldManager::ReactivatePooledActor(AActor* Actor, const FTransform& Transform, bool bEnableCollision)
 {
-    if (!UGameplayStatics::DoesSaveGameExist(SaveSlotName, 0)) return;
+    Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
 
-    CachedSaveGame = Cast<USandboxSaveGame>(UGameplayStatics::LoadGameFromSlot(SaveSlotName, 0));
-    if (!CachedSaveGame) return;
+    TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+    for (UPrimitiveComponent* Primitive : Primitives)
+    {
+        Primitive->SetComponentTickEnabled(Primitive->PrimaryComponentTick.bStartWithTickEnabled);
 
-    UWorld* World = GetWorld();
-    if (!World) return;
+        // Physics state comes back from the component template, velocities start at rest
+        const UPrimitiveComponent* Template = Cast<UPrimitiveComponent>(Primitive->GetArchetype());
+        if (Template && Template->BodyInstance.bSimulatePhysics)
+        {
+            Primitive->SetSimulatePhysics(true);
+            Primitive->SetPhysicsLinearVelocity(FVector::ZeroVector);
+            Primitive->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+        }
+    }
 
-    // --- CLEANUP SCENE ---
-    // Destroy existing constructed items
-    for (TActorIterator<AActor> It(World); It; ++It)
+    Actor->SetActorEnableCollision(bEnableCollision);
+    Actor->SetActorHiddenInGame(false);
+    Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+}
+
+void ASandboxWorldManager::EmptyActorPool()
+{
+    for (TPair<TObjectPtr<UClass>, FSandboxActorPoolBucket>& Entry : ActorPool)
     {
-        AActor* Actor = *It;
-        if (Actor->FindComponentByClass<USandboxIdentityComponent>())
+        for (AActor* Actor : Entry.Value.Actors)
         {
-            Actor->Destroy();
+            if (IsValid(Actor))
+            {
+                Actor->Destroy();
+            }
         }
     }
 
-    ClassCache.Empty();
-    DataAssetCache.Empty();
-    CurrentLoadIndex = 0;
+    ActorPool.Empty();
+    PooledActorCount = 0;
+}
+
+// =========================================================================
+// BATCH SPAWNING
+// =========================================================================
+
+int32 ASandboxWorldManager::QueueItemSpawns(USandboxItemData* ItemData, const TArray<FTransform>& Transforms)
+{
+    if (!ItemData || ItemData->ActorClassToSpawn.IsNull() || Transforms.Num() == 0) return 0;
 
-    if (CachedSaveGame->Items.Num() == 0)
+    // One class load for the whole batch instead of one per item
+    UClass* ActorClass = ItemData->ActorClassToSpawn.Get();
+    TArray<FSandboxQueuedSpawn>& TargetQueue = ActorClass ? SpawnQueue : PendingClassSpawns;
+
+    TargetQueue.Reserve(TargetQueue.Num() + Transforms.Num());
+    for (const FTransform& Transform : Transforms)
     {
-        bIsLoading = false;
-        OnLoadingCompleted();
-        return;
+        FSandboxQueuedSpawn& Spawn = TargetQueue.AddDefaulted_GetRef();
+        Spawn.ItemData = ItemData;
+        Spawn.ActorClass = ActorClass;
+        Spawn.Transform = Transform;
     }
 
-    // Enable tick to start time-sliced loading
-    bIsLoading = true;
-    SetActorTickEnabled(true);
+    if (ActorClass)
+    {
+        SetActorTickEnabled(true);
+        return Transforms.Num();
+    }
 
-    if (GEngine)
+    // OPTIMIZATION: Never a blocking load on the first stamp of a class, the items wait in PendingClassSpawns
+    const FSoftObjectPath ClassPath = ItemData->ActorClassToSpawn.ToSoftObjectPath();
+    if (ClassLoadHandles.Contains(ClassPath)) return Transforms.Num();
+
+    // Marks the class as in flight, the delegate can run before the request returns
+    ClassLoadHandles.Add(ClassPath);
+
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        ClassPath,
+        FStreamableDelegate::CreateUObject(this, &ASandboxWorldManager::OnQueuedClassLoaded, ClassPath)
+    );
+
+    if (!Handle.IsValid())
     {
-        GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Yellow, TEXT("Starting Async Load..."));
+        OnQueuedClassLoaded(ClassPath);
+        return Transforms.Num();
+    }
+
+    TSharedPtr<FStreamableHandle>* Pending = ClassLoadHandles.Find(ClassPath);
+    if (Pending && !Pending->IsValid())
+    {
+        *Pending = Handle;
     }
+    return Transforms.Num();
 }
 
-void ASandboxWorldManager::Tick(float DeltaTime)
+void ASandboxWorldManager::OnQueuedClassLoaded(FSoftObjectPath ClassPath)
 {
-    Super::Tick(DeltaTime);
+    if (!ClassLoadHandles.Remove(ClassPath)) return;
 
-    if (!bIsLoading || !CachedSaveGame)
+    // A failed load drops its items, like a null class did before
+    UClass* ActorClass = Cast<UClass>(ClassPath.ResolveObject());
+
+    // Kept in request order, other classes keep waiting
+    PendingClassSpawns.RemoveAll([this, &ClassPath, ActorClass](const FSandboxQueuedSpawn& Spawn)
     {
-        SetActorTickEnabled(false);
-        return;
+        if (!Spawn.ItemData || Spawn.ItemData->ActorClassToSpawn.ToSoftObjectPath() != ClassPath) return false;
+
+        if (ActorClass)
+        {
+            FSandboxQueuedSpawn& Queued = SpawnQueue.Add_GetRef(Spawn);
+            Queued.ActorClass = ActorClass;
+        }
+        return true;
+    }, EAllowShrinking::No);
+
+    if (SpawnQueueCursor < SpawnQueue.Num())
+    {
+        SetActorTickEnabled(true);
     }
+}
 
-    UWorld* World = GetWorld();
-    if (!World) return;
+void ASandboxWorldManager::CancelQueuedClassLoads()
+{
+    for (TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& Entry : ClassLoadHandles)
+    {
+        if (Entry.Value.IsValid())
+        {
+            Entry.Value->CancelHandle();
+        }
+    }
+    ClassLoadHandles.Reset();
+    PendingClassSpawns.Reset();
+}
 
-    FString CurrentLevelName = UGameplayStatics::GetCurrentLevelName(this);
-    int32 TotalItems = CachedSaveGame->Items.Num();
+void ASandboxWorldManager::TickSpawnQueue(double FrameBudget)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 StartCursor = SpawnQueueCursor;
+    const int32 ItemsPerClockCheck = GetItemsPerClockCheck(FrameBudget);
 
-    if (TotalItems == 0)
+    int32 ItemsUntilClockCheck = 0;
+    while (SpawnQueueCursor < SpawnQueue.Num())
     {
-        bIsLoading = false;
-        OnLoadingCompleted();
-        SetActorTickEnabled(false);
-        return;
+        if (ItemsUntilClockCheck-- <= 0)
+        {
+            if ((FPlatformTime::Seconds() - StartTime) > FrameBudget)
+            {
+                break;
+            }
+            ItemsUntilClockCheck = ItemsPerClockCheck - 1;
+        }
+
+        const FSandboxQueuedSpawn& Spawn = SpawnQueue[SpawnQueueCursor++];
+        AcquireItemActor(Spawn.ActorClass, Spawn.ItemData, Spawn.Transform, 0, false);
     }
 
-    double StartTime = FPlatformTime::Seconds();
+    RecordLoadSlice(FPlatformTime::Seconds() - StartTime, SpawnQueueCursor - StartCursor);
+
+    if (SpawnQueueCursor >= SpawnQueue.Num())
+    {
+        SpawnQueue.Reset();
+        SpawnQueueCursor = 0;
+
+        // Items still waiting on their class have not spawned yet
+        if (PendingClassSpawns.Num() == 0)
+        {
+            OnQueuedSpawnsCompleted();
+        }
+    }
+}
 
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+// =========================================================================
+// INSTANCING
+// =========================================================================
 
-    // --- TIME-SLICED LOOP ---
-    while (CurrentLoadIndex < TotalItems)
+int32 ASandboxWorldManager::GetInstancedItemCount() const
+{
+    int32 Count = 0;
+    for (const TPair<TObjectPtr<USandboxItemData>, FSandboxInstanceBatch>& Entry : InstanceBatches)
     {
-        // Check frame budget
-        if ((FPlatformTime::Seconds() - StartTime) > MaxFrameTimeBudget)
+        Count += Entry.Value.Items.Num();
+    }
+    return Count;
+}
+
+void ASandboxWorldManager::CollapseRestingItems()
+{
+    if (!bInstanceRestingItems || bIsLoading) return;
+
+    USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this);
+    if (!Registry) return;
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    for (auto It = PromotionTimes.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid() || Now - It.Value() >= PromotionCooldown)
         {
-            break;
+            It.RemoveCurrent();
+        }
+    }
+
+    // Only clean items: their saved record is current, so collapsing drops no pending change
+    TArray<USandboxIdentityComponent*> Candidates;
+    for (USandboxIdentityComponent* Identity : Registry->GetItems())
+    {
+        if (Identity && Identity->SourceItemData && Identity->SourceItemData->bAllowInstancing
+            && Identity->ItemId != 0 && !Identity->IsSaveDirty())
+        {
+            Candidates.Add(Identity);
         }
+    }
 
-        if (!CachedSaveGame->Items.IsValidIndex(CurrentLoadIndex))
+    int32 Collapsed = 0;
+    for (USandboxIdentityComponent* Identity : Candidates)
+    {
+        if (TryCollapseItem(Identity) && ++Collapsed >= MaxCollapsesPerPass)
         {
             break;
         }
+    }
+
+    // Collapsed actors went to the pool, cached view hits on them are stale
+    if (Collapsed > 0)
+    {
+        if (USandboxViewQuerySubsystem* ViewQuery = USandboxViewQuerySubsystem::Get(this))
+        {
+            ViewQuery->InvalidateViewHits();
+        }
+    }
+}
 
-        const FSavedItemCompact& ItemData = CachedSaveGame->Items[CurrentLoadIndex];
+bool ASandboxWorldManager::TryCollapseItem(USandboxIdentityComponent* Identity)
+{
+    AActor* Actor = Identity->GetOwner();
+    if (!IsValid(Actor) || Actor->GetAttachParentActor() || PromotionTimes.Contains(Actor)) return false;
+
+    // A single static mesh is all an instance can represent
+    TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+    if (Primitives.Num() != 1) return false;
+
+    UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Primitives[0]);
+    if (!MeshComponent || !MeshComponent->GetStaticMesh() || MeshComponent->IsA<UInstancedStaticMeshComponent>()) return false;
+
+    // Static only: an instance ignores physics, a sleeping or frozen body would float once its support goes away
+    if (MeshComponent->IsSimulatingPhysics()) return false;
 
-        // Filter: Spawn only items for current level
-        if (ItemData.LevelName == CurrentLevelName)
+    const USandboxPhysicsSleepSubsystem* SleepSubsystem = USandboxPhysicsSleepSubsystem::Get(this);
+    if (SleepSubsystem && SleepSubsystem->IsFrozen(MeshComponent)) return false;
+
+    FSandboxInstanceBatch& Batch = InstanceBatches.FindOrAdd(Identity->SourceItemData);
+    if (!Batch.Component)
+    {
+        UHierarchicalInstancedStaticMeshComponent* Instances = NewObject<UHierarchicalInstancedStaticMeshComponent>(this);
+        Instances->SetStaticMesh(MeshComponent->GetStaticMesh());
+        for (int32 MaterialIndex = 0; MaterialIndex < MeshComponent->GetNumMaterials(); ++MaterialIndex)
         {
-            int32 PIndex = ItemData.PaletteIndex;
+            Instances->SetMaterial(MaterialIndex, MeshComponent->GetMaterial(MaterialIndex));
+        }
 
-            if (CachedSaveGame->AssetPalette.IsValidIndex(PIndex))
-            {
-                UClass* ClassToSpawn = nullptr;
-                USandboxItemData* SourceData = nullptr;
+        // Same collision as the actor, so traces (grabber, placement) still hit the item
+        Instances->SetCollisionEnabled(MeshComponent->GetCollisionEnabled());
+        Instances->SetCollisionObjectType(MeshComponent->GetCollisionObjectType());
+        Instances->SetCollisionResponseToChannels(MeshComponent->GetCollisionResponseToChannels());
+        Instances->SetCastShadow(MeshComponent->CastShadow);
 
-                // Check Cache first
-                if (UClass** FoundClass = ClassCache.Find(PIndex))
-                {
-                    ClassToSpawn = *FoundClass;
-                    SourceData = *DataAssetCache.Find(PIndex);
-                }
-                else
-                {
-                    FString AssetPath = CachedSaveGame->AssetPalette[PIndex];
+        // Tag checks (e.g. the grabber's LiftableTag) see the actor's and the mesh's tags
+        Instances->ComponentTags = MeshComponent->ComponentTags;
+        for (const FName& Tag : Actor->Tags)
+        {
+            Instances->ComponentTags.AddUnique(Tag);
+        }
 
-                    if (!AssetPath.IsEmpty())
-                    {
-                        // Load Data Asset
-                        SourceData = Cast<USandboxItemData>(StaticLoadObject(USandboxItemData::StaticClass(), nullptr, *AssetPath));
-
-                        // Resolve Soft Class Ptr
-                        if (SourceData && !SourceData->ActorClassToSpawn.IsNull())
-                        {
-                            ClassToSpawn = SourceData->ActorClassToSpawn.LoadSynchronous();
-                            if (ClassToSpawn)
-                            {
-                                ClassCache.Add(PIndex, ClassToSpawn);
-                                DataAssetCache.Add(PIndex, SourceData);
-                            }
-                        }
-                    }
-                }
+        Instances->SetupAttachment(GetRootComponent());
+        Instances->RegisterComponent();
+        AddInstanceComponent(Instances);
 
-                // Spawn
-                if (ClassToSpawn && SourceData)
-                {
-                    AActor* NewActor = World->SpawnActor<AActor>(ClassToSpawn, ItemData.Transform, SpawnParams);
-                    if (NewActor)
-                    {
-                        USandboxIdentityComponent* Identity = NewActor->FindComponentByClass<USandboxIdentityComponent>();
-                        if (!Identity)
-                        {
-                            Identity = NewObject<USandboxIdentityComponent>(NewActor);
-                            Identity->RegisterComponent();
-                        }
-
-                        Identity->SourceItemData = SourceData;
-                        Identity->CurrentHealth = SourceData->DefaultHealth;
-                    }
-                }
-            }
+        Batch.Component = Instances;
+        Batch.ActorClass = Actor->GetClass();
+    }
+    else if (Batch.Component->GetStaticMesh() != MeshComponent->GetStaticMesh() || Batch.ActorClass != Actor->GetClass())
+    {
+        return false;
+    }
+
+    Batch.Component->AddInstance(MeshComponent->GetComponentTransform(), true);
+
+    FSandboxInstancedItem& Item = Batch.Items.AddDefaulted_GetRef();
+    Item.ItemId = Identity->ItemId;
+    Item.Health = Identity->CurrentHealth;
+    Item.ActorTransform = Actor->GetActorTransform();
+
+    // Still part of the world (and the save), only the actor goes away
+    PoolItemActor(Actor, false);
+    return true;
+}
+
+AActor* ASandboxWorldManager::PromoteInstancedHit(const FHitResult& Hit)
+{
+    const UPrimitiveComponent* HitComponent = Hit.GetComponent();
+    if (!HitComponent || Hit.Item == INDEX_NONE) return nullptr;
+
+    // For instanced components the hit's Item is the instance index
+    for (TPair<TObjectPtr<USandboxItemData>, FSandboxInstanceBatch>& Entry : InstanceBatches)
+    {
+        if (Entry.Value.Component == HitComponent)
+        {
+            return PromoteInstance(Entry.Key, Entry.Value, Hit.Item);
         }
+    }
+    return nullptr;
+}
 
-        CurrentLoadIndex++;
+bool ASandboxWorldManager::IsInstancedItemHit(const FHitResult& Hit) const
+{
+    const UPrimitiveComponent* HitComponent = Hit.GetComponent();
+    if (!HitComponent || Hit.Item == INDEX_NONE) return false;
+
+    for (const TPair<TObjectPtr<USandboxItemData>, FSandboxInstanceBatch>& Entry : InstanceBatches)
+    {
+        if (Entry.Value.Component == HitComponent)
+        {
+            return Entry.Value.Items.IsValidIndex(Hit.Item);
+        }
     }
+    return false;
+}
 
-    // Report Progress
-    float Percent = (TotalItems > 0) ? (float)CurrentLoadIndex / (float)TotalItems : 1.0f;
-    OnLoadingProgress(Percent);
+AActor* ASandboxWorldManager::PromoteInstance(USandboxItemData* ItemData, FSandboxInstanceBatch& Batch, int32 InstanceIndex)
+{
+    if (!Batch.Items.IsValidIndex(InstanceIndex)) return nullptr;
 
-    // Completion
-    if (CurrentLoadIndex >= TotalItems)
+    const FSandboxInstancedItem Item = Batch.Items[InstanceIndex];
+    RemoveInstanceAt(Batch, InstanceIndex);
+
+    AActor* Actor = AcquireItemActor(Batch.ActorClass, ItemData, Item.ActorTransform, Item.ItemId, false);
+    if (!Actor) return nullptr;
+
+    if (USandboxIdentityComponent* Identity = Actor->FindComponentByClass<USandboxIdentityComponent>())
     {
-        bIsLoading = false;
-        CachedSaveGame = nullptr;
-        ClassCache.Empty();
-        DataAssetCache.Empty();
+        Identity->CurrentHealth = Item.Health;
 
-        OnLoadingCompleted();
-        SetActorTickEnabled(false);
+        // Back exactly where it was saved
+        if (USandboxItemRegistry* Registry = USandboxItemRegistry::Get(this))
+        {
+            Registry->ClearDirty(Identity);
+        }
+    }
 
-        if (GEngine)
+    PromotionTimes.Add(Actor, GetWorld()->GetTimeSeconds());
+    return Actor;
+}
+
+void ASandboxWorldManager::RemoveInstanceAt(FSandboxInstanceBatch& Batch, int32 InstanceIndex)
+{
+    Batch.Component->RemoveInstance(InstanceIndex);
+
+    // Cached view hits may name an instance index that now means another item
+    if (USandboxViewQuerySubsystem* ViewQuery = USandboxViewQuerySubsystem::Get(this))
+    {
+        ViewQuery->InvalidateViewHits();
+    }
+
+    // HISM moves the last instance into the hole, plain ISM shifts the tail down
+    if (Batch.Component->SupportsRemoveSwap())
+    {
+        Batch.Items.RemoveAtSwap(InstanceIndex, 1, EAllowShrinking::No);
+    }
+    else
+    {
+        Batch.Items.RemoveAt(InstanceIndex, 1, EAllowShrinking::No);
+    }
+}
+
+void ASandboxWorldManager::ClearInstanceBatches()
+{
+    // Components are kept for the next load, only their instances go
+    for (TPair<TObjectPtr<USandboxItemData>, FSandboxInstanceBatch>& Entry : InstanceBatches)
+    {
+        if (Entry.Value.Component)
         {
-            GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Green, TEXT("Async Load Completed!"));
+            Entry.Value.Component->ClearInstances();
         }
+        Entry.Value.Items.Reset();
     }
+
+    PromotionTimes.Reset();
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "PhysicsEngine/PhysicsHandleComponent.h"
 #include "NiagaraSystem.h"
 #include "NiagaraComponent.h"
+#include "SandboxViewQuerySubsystem.h"
+#include "WorldCollision.h"
 #include "PhysicsGrabberComponent.generated.h"
 
 // Enum representing the current interaction state for the UI/Crosshair
@@ -19,6 +21,30 @@ enum class EGrabState : uint8
 // Delegate to notify UI about state changes
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGrabStateChanged, EGrabState, NewState);
 
+/** One body held by the grabber, through its own pooled handle. */
+USTRUCT()
+struct FSandboxGrabbedBody
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TObjectPtr<UPhysicsHandleComponent> Handle;
+
+    UPROPERTY()
+    TObjectPtr<UNiagaraComponent> VFX;
+
+    TWeakObjectPtr<UPrimitiveComponent> Component;
+
+    /** Camera-space offset from the hold point, zero for the body that was aimed at. */
+    FVector FormationOffset = FVector::ZeroVector;
+    FRotator RotationOffset = FRotator::ZeroRotator;
+
+    // Spring state
+    FVector TargetLocation = FVector::ZeroVector;
+    FVector PreviousTargetLocation = FVector::ZeroVector;
+    FVector TargetVelocity = FVector::ZeroVector;
+};
+
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class SANDBOX_API UPhysicsGrabberComponent : public UActorComponent
 {
@@ -39,7 +65,11 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Interaction")
     void ToggleGrab();
 
-    /** Releases the currently held object. */
+    /** Number of bodies currently held. */
+    UFUNCTION(BlueprintPure, Category = "Interaction")
+    int32 GetGrabbedCount() const { return GrabbedBodies.Num(); }
+
+    /** Releases the currently held object(s). */
     UFUNCTION(BlueprintCallable, Category = "Interaction")
     void ReleaseObject();
 
@@ -67,6 +97,39 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config")
     FName LiftableTag = "LiftableTag";
 
+    /** Bodies held at once. Above 1, liftable bodies around the aimed one are grabbed with it as a group. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config", meta = (ClampMin = "1"))
+    int32 MaxGrabbedObjects = 1;
+
+    /** Group grabs pick up liftable bodies within this distance of the aimed one (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config", meta = (ClampMin = "0.0"))
+    float GroupGrabRadius = 150.0f;
+
+    // --- CROSSHAIR TRACE ---
+
+    /** Seconds between crosshair traces while not holding. 0 traces every tick. Holding is always per-frame. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance", meta = (ClampMin = "0.0"))
+    float TraceUpdateInterval = 1.0f / 30.0f;
+
+    /**
+     * Issue the crosshair trace asynchronously, its result is applied on the next tick.
+     * This trace is the grabber's own and bypasses the shared per-frame view hit of USandboxViewQuerySubsystem.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    bool bAsyncTrace = false;
+
+    /** Camera movement below this skips the crosshair trace (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance", meta = (ClampMin = "0.0"))
+    float TraceSkipDistance = 1.0f;
+
+    /** Camera rotation below this skips the crosshair trace (degrees). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance", meta = (ClampMin = "0.0"))
+    float TraceSkipAngle = 0.25f;
+
+    /** A still camera traces again after this long anyway, objects move into view too (seconds). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance", meta = (ClampMin = "0.0"))
+    float MaxTraceSkipTime = 0.5f;
+
     // --- PHYSICS SETTINGS ---
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics")
@@ -75,27 +138,97 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics")
     float SpringDamping = 4.0f;
 
+    /** Fixed rate the hold spring is integrated at (Hz). Higher allows stiffer springs. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics", meta = (ClampMin = "1.0"))
+    float SpringStepRate = 120.0f;
+
+    /** Spring steps per frame at most; time beyond that is dropped during hitches. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics", meta = (ClampMin = "1"))
+    int32 MaxSpringStepsPerFrame = 8;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visuals")
     TObjectPtr<UNiagaraSystem> GrabVFXTemplate;
 
+    /** Inactive grab VFX components kept for reuse. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visuals", meta = (ClampMin = "0"))
+    int32 MaxPooledVFX = 8;
+
+    /** VFX components created vs. taken from the pool. */
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Visuals|Stats")
+    int32 VFXSpawned = 0;
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Visuals|Stats")
+    int32 VFXReused = 0;
+
 private:
+    /** The owner's handle, configured in BeginPlay; pooled handles copy its settings. Its tick is left to the owner. */
     UPROPERTY()
     TObjectPtr<UPhysicsHandleComponent> PhysicsHandle;
 
     UPROPERTY()
-    TObjectPtr<UNiagaraComponent> ActiveVFX;
+    TArray<FSandboxGrabbedBody> GrabbedBodies;
+
+    /** Idle handles, ticking disabled. */
+    UPROPERTY()
+    TArray<TObjectPtr<UPhysicsHandleComponent>> FreeHandles;
 
     bool bIsHolding;
     float CurrentHoldDistance;
 
-    // Physics interpolation state
-    FVector CurrentTargetLocation;
-    FVector CurrentTargetVelocity;
-    FRotator RotationOffset;
+    // Fixed-step spring state, shared by the group
+    float SpringTimeAccumulator = 0.0f;
+
+    /** One fixed spring step of a body towards GoalLocation. */
+    void StepSpring(FSandboxGrabbedBody& Body, const FVector& GoalLocation, float StepTime) const;
+
+    void GrabBody(UPrimitiveComponent* Component, const FVector& GrabLocation, const FRotator& CameraRotation);
+    void ReleaseBodyAt(int32 BodyIndex);
+
+    /** Liftable, grabbable bodies around the primary one, nearest first, up to MaxGrabbedObjects - 1. */
+    void FindGroupBodies(UPrimitiveComponent* PrimaryComponent, TArray<UPrimitiveComponent*>& OutBodies) const;
+
+    /** Inactive grab VFX, detached and deactivated. */
+    UPROPERTY()
+    TArray<TObjectPtr<UNiagaraComponent>> FreeVFX;
+
+    /** Reattaches and restarts a pooled VFX component, creating one only when the pool is empty. */
+    UNiagaraComponent* AcquireGrabVFX(UPrimitiveComponent* AttachTo);
+    void ReleaseGrabVFX(UNiagaraComponent* VFX);
 
-    /** Updates the trace logic to determine if we can grab something. */
-    void UpdateTraceState();
+    UPhysicsHandleComponent* AcquireHandle();
+    void ReleaseHandle(UPhysicsHandleComponent* Handle);
+
+    /** Copies the spring settings, never the grab state, of the owner's handle. */
+    void CopyHandleSettings(UPhysicsHandleComponent* Handle) const;
+
+    // Crosshair trace throttling state
+    float TimeSinceTrace = 0.0f;
+    FVector LastTraceLocation = FVector::ZeroVector;
+    FRotator LastTraceRotation = FRotator::ZeroRotator;
+    bool bHasTraced = false;
+    FTraceHandle PendingTraceHandle;
+
+    /** Updates the trace logic to determine if we can grab something. bForceTrace ignores throttling. */
+    void UpdateTraceState(float DeltaTime, bool bForceTrace = false);
+
+    void SetGrabState(EGrabState NewState);
+
+    void OnAsyncTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+    /** Liftable and grabbable, or a liftable instanced item (promoted only when grabbed). */
+    bool IsLiftableHit(const FHitResult& Hit) const;
+
+    /** Swaps a hit on a liftable instanced item for its promoted actor. */
+    void PromoteInstancedHit(FHitResult& Hit) const;
+
+    /** Simulating, or frozen by the sleep subsystem. */
+    bool IsGrabbableBody(const UPrimitiveComponent* Component) const;
 
     /** Helper to get player camera data. */
     bool GetPlayerViewPoint(FVector& OutLoc, FVector& OutDir, FRotator& OutRot) const;
+
+    APlayerController* GetOwningPlayerController() const;
+
+    /** This frame's camera trace, shared with every other system asking for the same player. */
+    bool QueryViewHit(FSandboxViewHit& OutViewHit, bool bForceFresh = false) const;
 };
\ No newline at end of file
@@ -6,10 +6,22 @@
 #include "SandboxDestructionAudio.generated.h"
 
 struct FChaosBreakEvent;
+struct FChaosCrumblingEvent;
+
+UENUM(BlueprintType)
+enum class ESandboxBreakNotifyLevel : uint8
+{
+    Off         UMETA(DisplayName = "Off"),
+    Crumbling   UMETA(DisplayName = "Crumbling (One Event Per Cluster)"),
+    Full        UMETA(DisplayName = "Full (One Event Per Fragment)")
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FSandboxBreakBatchDelegate, TConstArrayView<FChaosBreakEvent>);
 
 /**
  * Component responsible for playing audio when Chaos Geometry Collection breaks.
- * Optimized to prevent audio spam.
+ * Optimized to prevent audio spam: breaks are handed to USandboxDestructionAudioSubsystem,
+ * which merges them with every other collection's and bounds the voices started.
  */
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class SANDBOX_API USandboxDestructionAudio : public UActorComponent
@@ -21,24 +33,72 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
     UFUNCTION()
     void HandleBreakEvent(const FChaosBreakEvent& BreakEvent);
 
+    UFUNCTION()
+    void HandleCrumblingEvent(const FChaosCrumblingEvent& CrumblingEvent);
+
     void ShutdownAudioLogic();
 
+    /** Filters the frame's buffered breaks and hands them on at once. */
+    void ProcessBreakBatch();
+
 public:
+    /** Switches which Chaos notifications the geometry collection generates for this component. */
+    void SetNotifyLevel(ESandboxBreakNotifyLevel Level);
+
+    ESandboxBreakNotifyLevel GetNotifyLevel() const { return NotifyLevel; }
+    UGeometryCollectionComponent* GetGeometryCollection() const { return GeometryCollection.Get(); }
+
+    /** True once MaxAudioDuration has passed; the component no longer listens. */
+    bool IsShutdown() const { return bShutdown; }
+
+    /** Native hook, receives each frame's filtered breaks in one call. */
+    FSandboxBreakBatchDelegate OnBreakBatch;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio")
     TObjectPtr<USoundBase> BreakSound;
 
+    /** Optional, played instead of BreakSound for large merged clusters. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio")
+    TObjectPtr<USoundBase> BigBreakSound;
+
+    /** Throttle used only when the audio subsystem is unavailable. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio")
     float MinTimeBetweenSounds = 0.15f;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization")
     float MaxAudioDuration = 10.0f;
 
+    /** Lets USandboxDestructionAudioSubsystem pick the notification level by distance to the listener. Opt-in: distant breaks are heard as crumblings or not at all. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization")
+    bool bUseSignificanceLOD = false;
+
+    /** Breaks of lighter pieces are ignored (kg, 0 = no filter). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization", meta = (ClampMin = "0.0"))
+    float MinBreakMass = 0.0f;
+
+    /** Breaks of slower pieces are ignored (cm/s, 0 = no filter). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization", meta = (ClampMin = "0.0"))
+    float MinBreakSpeed = 0.0f;
+
+    /** Breaks farther than this from the audio listener are ignored (cm, 0 = no filter). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization", meta = (ClampMin = "0.0"))
+    float MaxListenerDistance = 0.0f;
+
 private:
     float LastSoundTime = 0.0f;
     FTimerHandle ShutdownTimerHandle;
     bool bIsActive = false;
+    bool bShutdown = false;
+
+    TWeakObjectPtr<UGeometryCollectionComponent> GeometryCollection;
+    ESandboxBreakNotifyLevel NotifyLevel = ESandboxBreakNotifyLevel::Off;
+
+    /** Breaks received this frame, processed once in TickComponent. */
+    TArray<FChaosBreakEvent> PendingBreaks;
 };
\ No newline at end of file
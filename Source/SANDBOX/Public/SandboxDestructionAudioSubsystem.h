@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SandboxDestructionAudio.h"
+#include "SandboxDestructionAudioSubsystem.generated.h"
+
+class USoundBase;
+
+/**
+ * Collects break sounds from every destructible in the world and plays them as clusters.
+ * Events close in space and time merge into one voice, louder (or a "big break" variant) the more
+ * it absorbed, and each window plays a bounded number of voices however much collapses.
+ * It also picks each registered collection's break notification level by distance to the listener.
+ */
+UCLASS()
+class SANDBOX_API USandboxDestructionAudioSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static USandboxDestructionAudioSubsystem* Get(const UObject* WorldContextObject);
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // --- CONFIGURATION ---
+
+    /** Events within the same cell of this size merge (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Destruction Audio", meta = (ClampMin = "1.0"))
+    float ClusterRadius = 600.0f;
+
+    /** Events are gathered this long before the window's clusters play (seconds). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Destruction Audio", meta = (ClampMin = "0.0"))
+    float WindowDuration = 0.1f;
+
+    /** Voices started per window, the largest clusters win. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Destruction Audio", meta = (ClampMin = "1"))
+    int32 MaxVoicesPerWindow = 4;
+
+    /** Clusters of at least this many events play the big break sound when one is given. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Destruction Audio", meta = (ClampMin = "1"))
+    int32 BigBreakThreshold = 8;
+
+    /** Volume added each time the merged event count doubles. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Destruction Audio", meta = (ClampMin = "0.0"))
+    float VolumePerDoubling = 0.15f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Destruction Audio", meta = (ClampMin = "0.0"))
+    float MaxVolumeMultiplier = 2.0f;
+
+    // --- SIGNIFICANCE ---
+
+    /** Collections within this distance of the listener notify every fragment (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Destruction Audio|Significance", meta = (ClampMin = "0.0"))
+    float AudibleRadius = 4000.0f;
+
+    /** Collections within this distance notify cluster crumblings only, beyond it nothing (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Destruction Audio|Significance", meta = (ClampMin = "0.0"))
+    float CrumblingRadius = 12000.0f;
+
+    /** Bounds radius over distance at which a collection notifies every fragment regardless of distance. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Destruction Audio|Significance", meta = (ClampMin = "0.0"))
+    float FullSignificance = 0.25f;
+
+    /** A collection keeps its level until it is this fraction past the radius that granted it. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Destruction Audio|Significance", meta = (ClampMin = "0.0"))
+    float SignificanceHysteresis = 0.1f;
+
+    /** Seconds between re-evaluations of every collection's level. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Destruction Audio|Significance", meta = (ClampMin = "0.0"))
+    float SignificanceInterval = 0.5f;
+
+    // --- API ---
+
+    /** Queues a break sound at Location. BigBreakSound is optional. */
+    void SubmitBreak(USoundBase* Sound, USoundBase* BigBreakSound, const FVector& Location);
+
+    /** Puts the component under significance control and sets its level right away. */
+    void RegisterDestructionAudio(USandboxDestructionAudio* AudioComponent);
+    void UnregisterDestructionAudio(USandboxDestructionAudio* AudioComponent);
+
+    /** Re-evaluates every registered collection now instead of at the next interval. */
+    UFUNCTION(BlueprintCallable, Category = "Destruction Audio")
+    void UpdateSignificance();
+
+    // --- COUNTERS ---
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Destruction Audio|Stats")
+    int32 EventsReceived = 0;
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Destruction Audio|Stats")
+    int32 VoicesPlayed = 0;
+
+    /** Clusters that lost to larger ones in their window. */
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Destruction Audio|Stats")
+    int32 ClustersDropped = 0;
+
+    /** Collections notifying every fragment after the last significance update. */
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Destruction Audio|Stats")
+    int32 FullNotifyCount = 0;
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Destruction Audio|Stats")
+    int32 CrumblingNotifyCount = 0;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FBreakCluster
+    {
+        TWeakObjectPtr<USoundBase> Sound;
+        TWeakObjectPtr<USoundBase> BigBreakSound;
+        FVector LocationSum = FVector::ZeroVector;
+        int32 Count = 0;
+    };
+
+    TArray<FBreakCluster> Clusters;
+    TMap<TPair<TObjectKey<USoundBase>, FIntVector>, int32> ClusterIndexByCell;
+
+    /** World time the current window opened, negative while no event is pending. */
+    double WindowStartTime = -1.0;
+
+    TArray<TWeakObjectPtr<USandboxDestructionAudio>> AudioComponents;
+    float TimeSinceSignificanceUpdate = 0.0f;
+
+    void FlushWindow();
+
+    bool GetListenerLocation(FVector& OutLocation) const;
+    ESandboxBreakNotifyLevel EvaluateSignificance(const USandboxDestructionAudio* AudioComponent, const FVector& ListenerLocation) const;
+};
\ No newline at end of file
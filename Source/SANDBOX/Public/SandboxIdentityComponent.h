@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Components/SceneComponent.h"
 #include "SandboxItemData.h"
 #include "SandboxIdentityComponent.generated.h"
 
@@ -18,13 +19,53 @@ public:
     USandboxIdentityComponent();
 
     /** Reference to the source DataAsset. Required for saving. */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Identity", meta = (ExposeOnSpawn = "true"))
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetSourceItemData, Category = "Identity", meta = (ExposeOnSpawn = "true"))
     TObjectPtr<USandboxItemData> SourceItemData;
 
+    /** Stable id of this item within its level's save block. 0 until first saved. */
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Identity")
+    int32 ItemId = 0;
+
+    UFUNCTION(BlueprintSetter)
+    void SetSourceItemData(USandboxItemData* NewData);
+
+    /** Flags this item for the next incremental save. */
+    UFUNCTION(BlueprintCallable, Category = "Identity")
+    void MarkSaveDirty();
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gameplay")
     float CurrentHealth = 100.0f;
 
     /** Called when player deals damage to this object. */
     UFUNCTION(BlueprintCallable, Category = "Gameplay")
     void TakeDamageFromPlayer(float Amount);
+
+    /**
+     * Identity of the item a trace hit. Instanced items are promoted to a full actor first,
+     * so damage and grabbing work the same for both.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Gameplay")
+    static USandboxIdentityComponent* ResolveHitItem(const FHitResult& Hit);
+
+    /** True while a change is waiting for the next incremental save. */
+    bool IsSaveDirty() const { return bSaveDirty; }
+
+protected:
+    virtual void OnRegister() override;
+    virtual void OnUnregister() override;
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    friend class USandboxItemRegistry;
+
+    /** Slot in USandboxItemRegistry's dense array, INDEX_NONE while unregistered. */
+    int32 RegistryIndex = INDEX_NONE;
+
+    /** Already queued in the registry's dirty list. */
+    bool bSaveDirty = false;
+
+    FDelegateHandle TransformUpdatedHandle;
+
+    void OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
 };
\ No newline at end of file
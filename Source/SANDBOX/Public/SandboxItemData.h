@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "CollisionShape.h"
 #include "SandboxItemData.generated.h"
 
 UENUM(BlueprintType)
@@ -13,6 +14,57 @@ enum class ESandboxItemCategory : uint8
     Misc            UMETA(DisplayName = "Misc")
 };
 
+/** What the placement shape of an item is derived from. */
+UENUM(BlueprintType)
+enum class ESandboxPlacementProxy : uint8
+{
+    BoundsBox       UMETA(DisplayName = "Bounds Box"),
+    BoundsSphere    UMETA(DisplayName = "Bounds Sphere"),
+    SimpleCollision UMETA(DisplayName = "Simple Collision (Single Box, Sphere Or Capsule)")
+};
+
+UENUM(BlueprintType)
+enum class ESandboxPlacementShapeType : uint8
+{
+    Box,
+    Sphere,
+    Capsule
+};
+
+/**
+ * Mesh-independent placement test shape in the item's local space.
+ * Plain data, so placement queries can be built on worker threads.
+ */
+USTRUCT(BlueprintType)
+struct SANDBOX_API FSandboxPlacementShape
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Placement")
+    ESandboxPlacementShapeType Type = ESandboxPlacementShapeType::Box;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Placement")
+    FVector Center = FVector::ZeroVector;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Placement")
+    FQuat Rotation = FQuat::Identity;
+
+    /** Box: half size. Sphere: X is the radius. Capsule: X is the radius, Z the half height. */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Placement")
+    FVector Extent = FVector::ZeroVector;
+
+    bool IsValid() const { return !Extent.IsNearlyZero(); }
+
+    static FSandboxPlacementShape MakeBox(const FBox& LocalBounds);
+    static FSandboxPlacementShape MakeSphere(const FBox& LocalBounds);
+
+    /** Scaled query shape. Scale is the item's 3D scale, ShrinkFactor keeps resting contacts from blocking. */
+    FCollisionShape MakeCollisionShape(const FVector& Scale, float ShrinkFactor) const;
+
+    /** World-space center and orientation of the shape for an item at ItemTransform. */
+    void GetWorldPose(const FTransform& ItemTransform, FVector& OutCenter, FQuat& OutRotation) const;
+};
+
 /**
  * Primary Data Asset representing a spawnable item.
  * Uses Soft References for memory optimization.
@@ -40,9 +92,45 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visuals")
     TSoftObjectPtr<UStaticMesh> GhostMesh;
 
+    /**
+     * Resting instances may be collapsed into a shared instanced mesh batch.
+     * Only for single-static-mesh actors without per-actor logic.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Optimization")
+    bool bAllowInstancing = false;
+
+    // --- PLACEMENT DATA ---
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Placement")
+    ESandboxPlacementProxy PlacementProxy = ESandboxPlacementProxy::BoundsBox;
+
+    /** Local bounds of GhostMesh. Filled on save/cook, or on load if the mesh is resident. */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Placement")
+    FBox LocalBounds = FBox(ForceInit);
+
+    /** Shape placement tests use instead of a live mesh component. */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Placement")
+    FSandboxPlacementShape PlacementShape;
+
+    UFUNCTION(BlueprintPure, Category = "Placement")
+    bool HasPlacementData() const { return LocalBounds.IsValid && PlacementShape.IsValid(); }
+
+    /**
+     * Recomputes LocalBounds and PlacementShape from GhostMesh.
+     * bLoadMesh loads the mesh synchronously if it is not resident. Returns false without a mesh.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Placement")
+    bool RefreshPlacementData(bool bLoadMesh = true);
+
     /** Default Health for physics objects. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics Stats")
     float DefaultHealth = 500.0f;
 
     virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+    virtual void PostLoad() override;
+
+#if WITH_EDITOR
+    virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 };
\ No newline at end of file
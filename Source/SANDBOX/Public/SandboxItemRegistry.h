@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SandboxItemRegistry.generated.h"
+
+class USandboxIdentityComponent;
+class ASandboxWorldManager;
+
+/**
+ * World-level registry of live sandbox items.
+ * Identity components add themselves on register, so save/load and gameplay
+ * queries iterate only placed items instead of every actor in the world.
+ */
+UCLASS()
+class SANDBOX_API USandboxItemRegistry : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Convenience accessor, returns nullptr for worlds without the registry (e.g. editor preview). */
+    static USandboxItemRegistry* Get(const UObject* WorldContextObject);
+
+    void RegisterItem(USandboxIdentityComponent* Identity);
+    void UnregisterItem(USandboxIdentityComponent* Identity);
+
+    // --- DIRTY TRACKING ---
+
+    /** Queues the item for the next incremental save (no-op if already queued). */
+    void MarkDirty(USandboxIdentityComponent* Identity);
+
+    /** Drops the item from the next incremental save, e.g. when it was just spawned from saved data. */
+    void ClearDirty(USandboxIdentityComponent* Identity);
+
+    /** Records the removal of a saved item destroyed during gameplay. */
+    void NotifyItemDestroyed(USandboxIdentityComponent* Identity);
+
+    /** Hands over everything changed since the last call and clears the dirty state. */
+    void ConsumeChanges(TArray<USandboxIdentityComponent*>& OutDirtyItems, TArray<int32>& OutRemovedItemIds);
+
+    /** Forgets pending changes, e.g. after a load or full save made the world and the save identical. */
+    void ClearChanges();
+
+    UFUNCTION(BlueprintPure, Category = "Sandbox|Registry")
+    int32 GetPendingChangeCount() const { return DirtyItems.Num() + RemovedItemIds.Num(); }
+
+    /** Dense list of live identities. Order is not stable across unregistration. */
+    const TArray<TObjectPtr<USandboxIdentityComponent>>& GetItems() const { return Items; }
+
+    UFUNCTION(BlueprintPure, Category = "Sandbox|Registry")
+    int32 GetItemCount() const { return Items.Num(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Sandbox|Registry")
+    TArray<USandboxIdentityComponent*> GetAllItems() const;
+
+    /** The world's manager, which owns instanced (actor-less) items. */
+    ASandboxWorldManager* GetWorldManager() const { return WorldManager.Get(); }
+    void SetWorldManager(ASandboxWorldManager* Manager) { WorldManager = Manager; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    UPROPERTY()
+    TArray<TObjectPtr<USandboxIdentityComponent>> Items;
+
+    UPROPERTY()
+    TArray<TObjectPtr<USandboxIdentityComponent>> DirtyItems;
+
+    TArray<int32> RemovedItemIds;
+
+    TWeakObjectPtr<ASandboxWorldManager> WorldManager;
+};
\ No newline at end of file
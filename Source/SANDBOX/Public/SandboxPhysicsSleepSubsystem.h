@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SandboxPhysicsSleepSubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+UENUM(BlueprintType)
+enum class ESandboxFreezeMode : uint8
+{
+    Sleep       UMETA(DisplayName = "Sleep (Solver Wakes On Contact)"),
+    Kinematic   UMETA(DisplayName = "Kinematic (Leaves The Solver)")
+};
+
+/**
+ * Watches simulating sandbox items and freezes them once they have settled.
+ * Stacks stop jittering and stop costing solver time; contact, grabbing and damage unfreeze them.
+ */
+UCLASS()
+class SANDBOX_API USandboxPhysicsSleepSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static USandboxPhysicsSleepSubsystem* Get(const UObject* WorldContextObject);
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // --- CONFIGURATION ---
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sleep")
+    ESandboxFreezeMode FreezeMode = ESandboxFreezeMode::Sleep;
+
+    /** Bodies slower than this count as still (cm/s). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sleep", meta = (ClampMin = "0.0"))
+    float LinearVelocityThreshold = 5.0f;
+
+    /** Bodies turning slower than this count as still (deg/s). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sleep", meta = (ClampMin = "0.0"))
+    float AngularVelocityThreshold = 5.0f;
+
+    /** Time a body must stay still before it is frozen (seconds). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sleep", meta = (ClampMin = "0.0"))
+    float SettleTime = 1.5f;
+
+    /** Bodies checked per frame, the rest are visited round-robin on later frames. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sleep", meta = (ClampMin = "1"))
+    int32 MaxBodiesCheckedPerFrame = 512;
+
+    /** Frozen bodies within this distance above a body that is unfrozen or leaves are woken with it (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sleep", meta = (ClampMin = "0.0"))
+    float SupportWakeMargin = 5.0f;
+
+    // --- API ---
+
+    /** Starts watching every simulating primitive of the actor. */
+    UFUNCTION(BlueprintCallable, Category = "Sleep")
+    void WatchActor(AActor* Actor);
+
+    UFUNCTION(BlueprintCallable, Category = "Sleep")
+    void WatchComponent(UPrimitiveComponent* Component);
+
+    /** Restores simulation on every frozen primitive of the actor and restarts their settle timers. */
+    UFUNCTION(BlueprintCallable, Category = "Sleep")
+    void UnfreezeActor(AActor* Actor);
+
+    UFUNCTION(BlueprintCallable, Category = "Sleep")
+    void UnfreezeComponent(UPrimitiveComponent* Component);
+
+    /** Stops watching the actor (e.g. it was pooled), restoring any frozen body first. */
+    void ForgetActor(AActor* Actor);
+
+    /** True if the component is frozen by this subsystem (kinematic frozen bodies report no simulation). */
+    UFUNCTION(BlueprintPure, Category = "Sleep")
+    bool IsFrozen(const UPrimitiveComponent* Component) const;
+
+    // --- COUNTERS ---
+
+    UFUNCTION(BlueprintPure, Category = "Sleep|Stats")
+    int32 GetWatchedBodyCount() const { return Bodies.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "Sleep|Stats")
+    int32 GetActiveBodyCount() const { return Bodies.Num() - FrozenBodyCount; }
+
+    UFUNCTION(BlueprintPure, Category = "Sleep|Stats")
+    int32 GetFrozenBodyCount() const { return FrozenBodyCount; }
+
+    /** Freezes and unfreezes since the world started. */
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Sleep|Stats")
+    int32 TotalFreezes = 0;
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Sleep|Stats")
+    int32 TotalUnfreezes = 0;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FWatchedBody
+    {
+        TWeakObjectPtr<UPrimitiveComponent> Component;
+        double LastCheckTime = 0.0;
+        float StillTime = 0.0f;
+        bool bFrozen = false;
+
+        /** World bounds when last checked, still known once the component is gone. */
+        FBox Bounds = FBox(ForceInit);
+
+        /** Hit notification state before a kinematic freeze enabled it. */
+        bool bHadHitNotify = false;
+    };
+
+    TArray<FWatchedBody> Bodies;
+    TMap<TWeakObjectPtr<UPrimitiveComponent>, int32> BodyIndexByComponent;
+
+    int32 FrozenBodyCount = 0;
+    int32 CheckCursor = 0;
+
+    void Freeze(FWatchedBody& Body, UPrimitiveComponent* Component);
+    void Unfreeze(FWatchedBody& Body, UPrimitiveComponent* Component);
+
+    /** Swap-removes the body, patching the index of the moved entry. */
+    void RemoveBodyAt(int32 Index);
+
+    /**
+     * Unfreezes frozen bodies resting on the support, and those resting on them.
+     * Losing support produces no hit, a kinematic frozen stack would otherwise stay hovering.
+     */
+    void WakeBodiesAbove(const FBox& SupportBounds);
+
+    /** Kinematic bodies are unfrozen when something simulating runs into them. */
+    UFUNCTION()
+    void OnFrozenBodyHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+};
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "UObject/ObjectKey.h"
+#include "SandboxPlacementQuerySubsystem.generated.h"
+
+class UStaticMesh;
+
+/**
+ * Async backing for the build preview queries in USandboxUtils.
+ * Line traces and overlap tests are issued through the async trace batch and answered
+ * with the previous frame's result. Overlap results are cached per placement, so a preview
+ * that has not moved costs no query at all.
+ */
+UCLASS()
+class SANDBOX_API USandboxPlacementQuerySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static USandboxPlacementQuerySubsystem* Get(const UObject* WorldContextObject);
+
+    // --- CONFIGURATION ---
+
+    /** Cached placement results older than this are queried again (seconds). Other items keep moving. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement", meta = (ClampMin = "0.0"))
+    float CacheLifetime = 0.5f;
+
+    /** Location quantization of the cache key (cm). Grid-snapped previews land on the same key anyway. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement", meta = (ClampMin = "0.1"))
+    float CacheCellSize = 1.0f;
+
+    /** The cache is flushed once it holds this many placements. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement", meta = (ClampMin = "1"))
+    int32 MaxCachedPlacements = 1024;
+
+    /** A view ray closer than this to the last traced one reuses its hit (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Placement", meta = (ClampMin = "0.0"))
+    float TraceReuseDistance = 0.5f;
+
+    // --- API ---
+
+    /**
+     * Returns the last completed trace of this requester and issues a new async trace if the ray moved.
+     * Returns false if the requester has no completed trace yet.
+     */
+    bool RequestLineTrace(const UObject* Requester, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params, FHitResult& OutHit, bool& bOutHit);
+
+    /**
+     * Returns the cached blocking-overlap result for the placement, or the requester's previous result
+     * while an async overlap for the new placement is in flight. Returns false if neither exists yet.
+     */
+    bool RequestPlacementOverlap(const UObject* Requester, const FVector& Location, const FQuat& Rotation, const UStaticMesh* Mesh, const AActor* IgnoredActor, const FVector& BoxCenter, const FVector& BoxExtent, const FCollisionQueryParams& Params, bool& bOutBlocked);
+
+    /** Records a synchronous result, so the first frame of a preview still fills the cache. */
+    void StorePlacementResult(const UObject* Requester, const FVector& Location, const FQuat& Rotation, const UStaticMesh* Mesh, const AActor* IgnoredActor, bool bBlocked);
+
+    /** Drops every cached placement, e.g. after a batch of items was placed or loaded. */
+    UFUNCTION(BlueprintCallable, Category = "Placement")
+    void InvalidateCache();
+
+    // --- COUNTERS ---
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Placement|Stats")
+    int32 CacheHits = 0;
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Placement|Stats")
+    int32 AsyncQueriesIssued = 0;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FPlacementKey
+    {
+        FIntVector Cell = FIntVector::ZeroValue;
+        uint16 Pitch = 0;
+        uint16 Yaw = 0;
+        uint16 Roll = 0;
+        TObjectKey<UStaticMesh> Mesh;
+        TObjectKey<AActor> IgnoredActor;
+
+        bool operator==(const FPlacementKey& Other) const
+        {
+            return Cell == Other.Cell && Pitch == Other.Pitch && Yaw == Other.Yaw && Roll == Other.Roll
+                && Mesh == Other.Mesh && IgnoredActor == Other.IgnoredActor;
+        }
+
+        friend uint32 GetTypeHash(const FPlacementKey& Key)
+        {
+            uint32 Hash = GetTypeHash(Key.Cell);
+            Hash = HashCombine(Hash, (uint32)Key.Pitch | ((uint32)Key.Yaw << 16));
+            Hash = HashCombine(Hash, Key.Roll);
+            Hash = HashCombine(Hash, GetTypeHash(Key.Mesh));
+            return HashCombine(Hash, GetTypeHash(Key.IgnoredActor));
+        }
+    };
+
+    struct FCachedPlacement
+    {
+        double Time = 0.0;
+        bool bBlocked = false;
+        bool bHasResult = false;
+        bool bPending = false;
+    };
+
+    struct FRequesterTrace
+    {
+        FVector Start = FVector::ZeroVector;
+        FVector End = FVector::ZeroVector;
+        FHitResult Hit;
+        double Time = 0.0;
+        bool bHit = false;
+        bool bHasResult = false;
+        bool bPending = false;
+    };
+
+    struct FRequesterPlacement
+    {
+        bool bBlocked = false;
+        bool bHasResult = false;
+    };
+
+    TMap<FPlacementKey, FCachedPlacement> PlacementCache;
+    TMap<TObjectKey<UObject>, FRequesterTrace> RequesterTraces;
+    TMap<TObjectKey<UObject>, FRequesterPlacement> RequesterPlacements;
+
+    /** Registry item count when the cache was last valid; placing or removing an item flushes it. */
+    int32 CachedItemCount = INDEX_NONE;
+
+    FPlacementKey MakeKey(const FVector& Location, const FQuat& Rotation, const UStaticMesh* Mesh, const AActor* IgnoredActor) const;
+
+    /** Flushes the cache if the registry changed, and bounds its size. */
+    void ValidateCache();
+
+    void OnLineTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, TObjectKey<UObject> Requester);
+    void OnOverlapDone(const FTraceHandle& Handle, FOverlapDatum& Datum, FPlacementKey Key, TObjectKey<UObject> Requester);
+
+    /** Drops the state of requesters that no longer exist. */
+    template <typename ValueType>
+    static void PruneRequesters(TMap<TObjectKey<UObject>, ValueType>& Requesters);
+};
\ No newline at end of file
@@ -4,6 +4,75 @@
 #include "GameFramework/SaveGame.h"
 #include "SandboxSaveGame.generated.h"
 
+/** Save layout revisions. Files without a version tag are treated as Initial. */
+namespace ESandboxSaveVersion
+{
+    enum Type : int32
+    {
+        // Flat Items array, every entry tagged with its LevelName
+        Initial = 0,
+        // Items grouped into one block per level
+        PerLevelBlocks = 1,
+        // Optional quantized item encoding stored in FSavedLevelData::PackedItems
+        PackedTransforms = 2,
+        // Stable item ids and SaveRevision, enabling the incremental journal slot
+        StableItemIds = 3,
+        // Per-item sleep state and velocities (FSavedPhysicsState)
+        PhysicsState = 4,
+
+        VersionPlusOne,
+        Latest = VersionPlusOne - 1
+    };
+}
+
+UENUM(BlueprintType)
+enum class ESandboxTransformEncoding : uint8
+{
+    Full        UMETA(DisplayName = "Full Precision"),
+    Quantized   UMETA(DisplayName = "Quantized (Packed)")
+};
+
+/** Controls how item transforms are written to disk. */
+USTRUCT(BlueprintType)
+struct FSandboxTransformQuantization
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Compression")
+    ESandboxTransformEncoding Encoding = ESandboxTransformEncoding::Full;
+
+    /** Fixed-point resolution of positions relative to the level origin (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Compression", meta = (ClampMin = "0.001"))
+    float PositionStep = 0.1f;
+
+    /** Items whose decoded position differs by more than this (cm) are stored at full precision. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Compression", meta = (ClampMin = "0.0"))
+    float MaxPositionError = 0.1f;
+
+    /** Items whose decoded rotation differs by more than this (degrees) are stored at full precision. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Compression", meta = (ClampMin = "0.0"))
+    float MaxRotationErrorDegrees = 0.01f;
+};
+
+/** Physics state of an item at save time, restored so loaded stacks don't all wake at once. */
+USTRUCT(BlueprintType)
+struct FSavedPhysicsState
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    bool bAsleep = false;
+
+    /** Only meaningful for awake bodies (cm/s and deg/s). */
+    UPROPERTY()
+    FVector3f LinearVelocity = FVector3f::ZeroVector;
+
+    UPROPERTY()
+    FVector3f AngularVelocity = FVector3f::ZeroVector;
+
+    bool HasVelocity() const { return !LinearVelocity.IsZero() || !AngularVelocity.IsZero(); }
+};
+
 USTRUCT(BlueprintType)
 struct FSavedItemCompact
 {
@@ -12,14 +81,96 @@ struct FSavedItemCompact
     UPROPERTY()
     int32 PaletteIndex = -1;
 
+    /** Stable id within the level, used by the incremental journal. 0 means not assigned yet. */
+    UPROPERTY()
+    int32 ItemId = 0;
+
     UPROPERTY()
     FTransform Transform;
 
-    /** Determines which level this item belongs to. */
+    UPROPERTY()
+    FSavedPhysicsState Physics;
+
+    /** Legacy: only set for items loaded from Initial saves, before migration into level blocks. */
     UPROPERTY()
     FString LevelName;
 };
 
+/**
+ * All items saved for a single level.
+ * Loading or saving a level touches only its own block.
+ */
+USTRUCT(BlueprintType)
+struct FSavedLevelData
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FString LevelName;
+
+    UPROPERTY()
+    TArray<FSavedItemCompact> Items;
+
+    /** Next free ItemId in this level. */
+    UPROPERTY()
+    int32 NextItemId = 1;
+
+    /** Compressed copy of Items (quantized or full precision per the save's encoding). Items is rebuilt from it on load. */
+    UPROPERTY()
+    TArray<uint8> PackedItems;
+
+    /** True while PackedItems matches Items. Must be cleared whenever Items is modified. */
+    bool bPackedItemsValid = false;
+
+    /** Gives every item without an id a fresh one. Returns true if any id was assigned. */
+    bool AssignMissingItemIds();
+
+    /** Inserts the item or replaces the one with the same ItemId. */
+    void UpsertItem(const FSavedItemCompact& Item);
+
+    void RemoveItem(int32 ItemId);
+
+    /** Item with the given id, or nullptr. Invalidated by any modification of Items. */
+    const FSavedItemCompact* FindItem(int32 ItemId);
+
+    /** Must be called whenever Items is assigned or modified other than through the helpers above. */
+    void InvalidateItemIndex() { bItemIndexValid = false; }
+
+private:
+    /** Lazily built ItemId -> index into Items, used by UpsertItem/RemoveItem/FindItem. */
+    TMap<int32, int32> ItemIndexById;
+
+    /** False until ItemIndexById is rebuilt after Items changed outside the helpers. */
+    bool bItemIndexValid = false;
+
+    void EnsureItemIndex();
+};
+
+/** Changes recorded for one level since the last full save. */
+USTRUCT()
+struct FSavedLevelJournal
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FString LevelName;
+
+    /** Added or modified items, at most one record per ItemId. */
+    UPROPERTY()
+    TArray<FSavedItemCompact> Upserts;
+
+    UPROPERTY()
+    TArray<int32> Removals;
+
+private:
+    friend class USandboxSaveJournal;
+
+    /** Lazily built ItemId -> index into Upserts. */
+    TMap<int32, int32> UpsertIndexById;
+};
+
+class USandboxSaveJournal;
+
 /**
  * Main SaveGame class containing player progress and world state.
  */
@@ -29,6 +180,35 @@ class SANDBOX_API USandboxSaveGame : public USaveGame
     GENERATED_BODY()
 
 public:
+    virtual void Serialize(FArchive& Ar) override;
+
+    /** Returns the block for the level, or nullptr if nothing was saved for it. */
+    FSavedLevelData* FindLevel(const FString& LevelName);
+    const FSavedLevelData* FindLevel(const FString& LevelName) const;
+
+    FSavedLevelData& FindOrAddLevel(const FString& LevelName);
+
+    /** Encodes and compresses Level.Items into Level.PackedItems. Full encoding keeps every transform exact. Safe on a worker. */
+    static void PackLevel(FSavedLevelData& Level, const FSandboxTransformQuantization& Settings);
+
+    /** Decodes Level.PackedItems back into Level.Items. Returns false if the data is corrupt. */
+    static bool UnpackLevel(FSavedLevelData& Level);
+
+    /** Replays journal records on top of this save. Ignored if the journal was written against another revision. */
+    bool ApplyJournal(const USandboxSaveJournal& Journal);
+
+    /** Layout revision this save was written with. */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Version")
+    int32 SaveVersion = ESandboxSaveVersion::Initial;
+
+    /** Incremented on every full save, ties the journal slot to the base it was recorded against. */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Version")
+    int32 SaveRevision = 0;
+
+    /** Transform encoding used when this save is written. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Version")
+    FSandboxTransformQuantization TransformQuantization;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Player")
     FTransform PlayerTransform;
 
@@ -36,8 +216,12 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World")
     TArray<FString> AssetPalette;
 
-    /** List of all spawned items in the world. */
+    /** Level table: one block of spawned items per level. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World")
+    TArray<FSavedLevelData> Levels;
+
+    /** Legacy flat item list. Emptied into Levels when an Initial save is loaded. */
+    UPROPERTY()
     TArray<FSavedItemCompact> Items;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Progress")
@@ -53,4 +237,44 @@ public:
 
     UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Settings")
     FString LanguageCode = "en";
+
+private:
+    /** Moves legacy flat Items into per-level blocks. */
+    void MigrateLegacyItems();
+};
+
+/**
+ * Delta journal stored next to the main slot.
+ * Incremental saves rewrite only this small object; it is merged into the base on compaction.
+ */
+UCLASS()
+class SANDBOX_API USandboxSaveJournal : public USaveGame
+{
+    GENERATED_BODY()
+
+public:
+    /** USandboxSaveGame::SaveRevision this journal applies to. */
+    UPROPERTY()
+    int32 BaseRevision = 0;
+
+    /** Copy of the base palette including entries added since the last full save. */
+    UPROPERTY()
+    TArray<FString> AssetPalette;
+
+    UPROPERTY()
+    TArray<FSavedLevelJournal> Levels;
+
+    void RecordUpsert(const FString& LevelName, const FSavedItemCompact& Item);
+    void RecordRemoval(const FString& LevelName, int32 ItemId);
+
+    /** Total number of records, used to decide when to compact. */
+    int32 GetRecordCount() const;
+
+    /** Drops all records and rebinds the journal to a new base revision. */
+    void Reset(int32 NewBaseRevision);
+
+private:
+    FSavedLevelJournal& FindOrAddLevel(const FString& LevelName);
+
+    static void EnsureUpsertIndex(FSavedLevelJournal& Level);
 };
\ No newline at end of file
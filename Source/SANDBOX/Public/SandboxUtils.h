@@ -7,6 +7,9 @@
 #include "Sound/SoundClass.h"
 #include "SandboxUtils.generated.h"
 
+class USandboxItemData;
+class APlayerController;
+
 /**
  * Global Utility Library.
  * Bridges C++ performance with Blueprint usability.
@@ -34,6 +37,17 @@ public:
         FTransform& OutTransform
     );
 
+    /** CalculatePlacementTransform on the player's shared per-frame view trace (no extra scene query). */
+    UFUNCTION(BlueprintCallable, Category = "Sandbox|Math")
+    static bool CalculatePlacementTransformFromView(
+        APlayerController* PlayerController,
+        float TraceDistance,
+        float GridSize,
+        bool bAlignToNormal,
+        float AdditionalYaw,
+        FTransform& OutTransform
+    );
+
     /** Validates placement using collision overlap check. */
     UFUNCTION(BlueprintCallable, Category = "Sandbox|Collision", meta = (WorldContext = "WorldContextObject"))
     static bool IsPlacementValid(
@@ -44,6 +58,87 @@ public:
         AActor* IgnoredActor
     );
 
+    /** IsPlacementValid from the item's cached placement shape, no mesh component needed. */
+    UFUNCTION(BlueprintCallable, Category = "Sandbox|Collision", meta = (WorldContext = "WorldContextObject"))
+    static bool IsItemPlacementValid(
+        const UObject* WorldContextObject,
+        USandboxItemData* ItemData,
+        const FTransform& ItemTransform,
+        AActor* IgnoredActor
+    );
+
+    /**
+     * CalculatePlacementTransform on an async trace: uses the previous frame's hit and
+     * traces again only when the view ray moved. Meant for per-frame previews.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Sandbox|Math", meta = (WorldContext = "WorldContextObject"))
+    static bool CalculatePlacementTransformAsync(
+        const UObject* WorldContextObject,
+        const FVector CameraLocation,
+        const FVector CameraForward,
+        float TraceDistance,
+        float GridSize,
+        bool bAlignToNormal,
+        float AdditionalYaw,
+        FTransform& OutTransform
+    );
+
+    /**
+     * IsPlacementValid on an async overlap, cached per grid cell, rotation and mesh.
+     * An unchanged preview costs no query; a new position reports the previous result for one frame.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Sandbox|Collision", meta = (WorldContext = "WorldContextObject"))
+    static bool IsPlacementValidAsync(
+        const UObject* WorldContextObject,
+        const FVector ItemLocation,
+        const FQuat ItemRotation,
+        UStaticMeshComponent* MeshComponent,
+        AActor* IgnoredActor
+    );
+
+    /** Forces fresh placement queries, e.g. after items were placed or moved by script. */
+    UFUNCTION(BlueprintCallable, Category = "Sandbox|Collision", meta = (WorldContext = "WorldContextObject"))
+    static void InvalidatePlacementCache(const UObject* WorldContextObject);
+
+    /**
+     * Validates a pattern of placements (rows, grids, pasted selections) relative to Origin in one pass.
+     * Slots are tested against the world in parallel, not against each other. Returns the number of valid slots.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Sandbox|Collision", meta = (WorldContext = "WorldContextObject"))
+    static int32 ValidatePlacementBatch(
+        const UObject* WorldContextObject,
+        const FTransform& Origin,
+        const TArray<FTransform>& RelativeTransforms,
+        const FBox& LocalBounds,
+        AActor* IgnoredActor,
+        TArray<FTransform>& OutWorldTransforms,
+        TArray<bool>& OutValidSlots
+    );
+
+    /** ValidatePlacementBatch using the item's cached placement shape instead of explicit bounds. */
+    UFUNCTION(BlueprintCallable, Category = "Sandbox|Collision", meta = (WorldContext = "WorldContextObject"))
+    static int32 ValidateItemPlacementBatch(
+        const UObject* WorldContextObject,
+        USandboxItemData* ItemData,
+        const FTransform& Origin,
+        const TArray<FTransform>& RelativeTransforms,
+        AActor* IgnoredActor,
+        TArray<FTransform>& OutWorldTransforms,
+        TArray<bool>& OutValidSlots
+    );
+
+    /**
+     * Queues the valid slots of a validated batch on the world manager's time-sliced spawner. Returns the number queued.
+     * ValidSlots must hold one entry per transform, as filled by the validation call; otherwise nothing is queued.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Sandbox|Collision", meta = (WorldContext = "WorldContextObject"))
+    static int32 SpawnPlacementBatch(
+        const UObject* WorldContextObject,
+        USandboxItemData* ItemData,
+        const TArray<FTransform>& WorldTransforms,
+        const TArray<bool>& ValidSlots
+    );
+
     // =========================================================================
     // SECTION: SETTINGS & OPTIMIZATION
     // =========================================================================
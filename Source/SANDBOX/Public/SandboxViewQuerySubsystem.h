@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SandboxViewQuerySubsystem.generated.h"
+
+class APlayerController;
+
+/** Result of a player's view-ray trace. */
+USTRUCT(BlueprintType)
+struct FSandboxViewHit
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "View Query")
+    bool bHit = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "View Query")
+    FHitResult Hit;
+
+    UPROPERTY(BlueprintReadOnly, Category = "View Query")
+    FVector ViewLocation = FVector::ZeroVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "View Query")
+    FRotator ViewRotation = FRotator::ZeroRotator;
+
+    /** Distance the result is valid for, hits beyond it are dropped. */
+    UPROPERTY(BlueprintReadOnly, Category = "View Query")
+    float TraceDistance = 0.0f;
+};
+
+/**
+ * Traces each player's camera ray once per frame and shares the hit between the grabber,
+ * the placement tool and interaction UI. Keyed per PlayerController, so split-screen players
+ * each pay for one trace instead of one per system.
+ */
+UCLASS()
+class SANDBOX_API USandboxViewQuerySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static USandboxViewQuerySubsystem* Get(const UObject* WorldContextObject);
+
+    /**
+     * The shared trace covers at least this far (cm). Beyond it, it is sized to the longest ray
+     * requested for the player this frame or last frame, so a lone short caller pays for no more.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "View Query", meta = (ClampMin = "0.0"))
+    float SharedTraceDistance = 0.0f;
+
+    /**
+     * This frame's view hit of the player, traced on first request.
+     * bForceFresh traces again, e.g. right after the caller changed the world along the ray.
+     */
+    UFUNCTION(BlueprintCallable, Category = "View Query")
+    bool GetViewHit(APlayerController* PlayerController, float TraceDistance, FSandboxViewHit& OutViewHit, bool bForceFresh = false);
+
+    /** Drops every cached hit, e.g. when the component a hit points at changed meaning (instances removed). */
+    UFUNCTION(BlueprintCallable, Category = "View Query")
+    void InvalidateViewHits();
+
+    // --- COUNTERS ---
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "View Query|Stats")
+    int32 TracesPerformed = 0;
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "View Query|Stats")
+    int32 TracesShared = 0;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FCachedViewHit
+    {
+        FSandboxViewHit ViewHit;
+        uint64 FrameNumber = 0;
+        bool bValid = false;
+
+        /** Longest ray requested in RequestFrame and in the frame before it. */
+        float RequestedDistance = 0.0f;
+        float PreviousRequestedDistance = 0.0f;
+        uint64 RequestFrame = 0;
+    };
+
+    TMap<TObjectKey<APlayerController>, FCachedViewHit> ViewHits;
+
+    void TraceView(APlayerController* PlayerController, float TraceDistance, FCachedViewHit& OutCached);
+};
\ No newline at end of file
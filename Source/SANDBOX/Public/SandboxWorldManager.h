@@ -4,8 +4,87 @@
 #include "GameFramework/Actor.h"
 #include "SandboxSaveGame.h"
 #include "SandboxItemData.h"
+#include "Engine/StreamableManager.h"
 #include "SandboxWorldManager.generated.h"
 
+class USaveGame;
+class USandboxIdentityComponent;
+class UHierarchicalInstancedStaticMeshComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWorldSaveCompleted, bool, bSuccess);
+
+/** How the time-sliced load loop sizes its per-frame budget. */
+UENUM(BlueprintType)
+enum class ESandboxLoadBudgetMode : uint8
+{
+    Fixed           UMETA(DisplayName = "Fixed (MaxFrameTimeBudget)"),
+    LoadingScreen   UMETA(DisplayName = "Loading Screen (Most Of The Frame)"),
+    Background      UMETA(DisplayName = "Background (Remaining Frame Slack)")
+};
+
+/** What loaded items do with their physics bodies until the whole load batch is placed. */
+UENUM(BlueprintType)
+enum class ESandboxLoadPhysicsMode : uint8
+{
+    Immediate   UMETA(DisplayName = "Immediate (Simulate On Spawn)"),
+    Asleep      UMETA(DisplayName = "Asleep (Wake On Completion)"),
+    Disabled    UMETA(DisplayName = "Disabled (Create Bodies On Completion)")
+};
+
+/** Inactive actors of one class kept for reuse. */
+USTRUCT()
+struct FSandboxActorPoolBucket
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<TObjectPtr<AActor>> Actors;
+};
+
+/** One item waiting in the batch spawn queue. */
+USTRUCT()
+struct FSandboxQueuedSpawn
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TObjectPtr<USandboxItemData> ItemData;
+
+    UPROPERTY()
+    TObjectPtr<UClass> ActorClass;
+
+    FTransform Transform;
+};
+
+/** Saved state of one item collapsed into an instance batch. */
+USTRUCT()
+struct FSandboxInstancedItem
+{
+    GENERATED_BODY()
+
+    int32 ItemId = 0;
+    float Health = 0.0f;
+
+    /** Actor transform (saved and respawned), the instance uses the mesh component's transform. */
+    FTransform ActorTransform;
+};
+
+/** Resting items of one USandboxItemData drawn as instances of a single HISM. */
+USTRUCT()
+struct FSandboxInstanceBatch
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TObjectPtr<UHierarchicalInstancedStaticMeshComponent> Component;
+
+    UPROPERTY()
+    TObjectPtr<UClass> ActorClass;
+
+    /** Parallel to the component's instances. */
+    TArray<FSandboxInstancedItem> Items;
+};
+
 /**
  * Manages async loading/saving of world state.
  * Implements Time-Sliced processing to prevent frame drops during mass spawning.
@@ -17,31 +96,497 @@ class SANDBOX_API ASandboxWorldManager : public AActor
 
 public:
     ASandboxWorldManager();
+    virtual void BeginPlay() override;
     virtual void Tick(float DeltaTime) override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-    // Time budget per frame for spawning (seconds). Default 5ms.
+    // Time budget per frame for spawning (seconds). Default 5ms. Upper bound in Background mode.
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization")
     double MaxFrameTimeBudget = 0.005;
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization")
+    ESandboxLoadBudgetMode LoadBudgetMode = ESandboxLoadBudgetMode::Fixed;
+
+    /** Frame rate the adaptive budget modes try to hold. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization", meta = (ClampMin = "1.0"))
+    float TargetFrameRate = 60.0f;
+
+    /** Share of the target frame spent spawning behind a loading screen. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float LoadingScreenBudgetFraction = 0.85f;
+
+    /** Background mode never drops below this, so loading always makes progress (seconds). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization", meta = (ClampMin = "0.0"))
+    double MinFrameTimeBudget = 0.0005;
+
+    /** Upper bound on items spawned between two clock reads. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization", meta = (ClampMin = "1"))
+    int32 MaxItemsPerClockCheck = 32;
+
+    /** Spawn items grid cell by grid cell, nearest to the player first. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization")
+    bool bPrioritizeLoadByDistance = true;
+
+    /** Edge length of the load ordering grid cells (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization", meta = (ClampMin = "100.0"))
+    float LoadCellSize = 2000.0f;
+
+    /** Player movement during loading that re-sorts the remaining cells (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization", meta = (ClampMin = "0.0"))
+    float LoadReprioritizeDistance = 1000.0f;
+
+    // --- STREAMING ---
+
+    /** Keep only items in cells around the player alive; the rest live in the save. Applied by LoadWorld. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming")
+    bool bStreamItemsByCell = false;
+
+    /** Edge length of a streaming cell (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming", meta = (ClampMin = "100.0"))
+    float StreamingCellSize = 5000.0f;
+
+    /** Cells closer than this to the player are loaded (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming", meta = (ClampMin = "0.0"))
+    float StreamingRadius = 15000.0f;
+
+    /** Extra distance before a loaded cell unloads again, avoids churn at the boundary (cm). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming", meta = (ClampMin = "0.0"))
+    float StreamingHysteresis = 2500.0f;
+
+    /** Share of OnLoadingProgress reserved for the asset preload phase (0..1). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float PreloadProgressWeight = 0.25f;
+
+    /** Spawn loaded items deferred, so identity data is in place before construction and BeginPlay run. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization")
+    bool bDeferredSpawning = true;
+
+    /** Asleep avoids solver work during the load, Disabled also keeps bodies out of the broadphase. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Optimization")
+    ESandboxLoadPhysicsMode LoadPhysicsMode = ESandboxLoadPhysicsMode::Asleep;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SaveSystem")
     FString SaveSlotName = "SandboxSave01";
 
+    /** Store sleep state and velocities per item, so settled stacks load asleep. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SaveSystem")
+    bool bSavePhysicsState = true;
+
+    /** Apply saved physics state on load. Items saved asleep are put to sleep right after spawning. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SaveSystem")
+    bool bRestorePhysicsState = true;
+
+    /** Transform encoding applied to the slot on every SaveWorld. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SaveSystem")
+    FSandboxTransformQuantization SaveTransformQuantization;
+
+    /**
+     * Captures the current level on the game thread, then encodes and writes it in the background.
+     * Requests made while a save is in flight are coalesced into one follow-up save.
+     */
     UFUNCTION(BlueprintCallable, Category = "SaveSystem")
     void SaveWorld();
 
+    /** Forces the next save to write a full snapshot and clear the journal. */
+    UFUNCTION(BlueprintCallable, Category = "SaveSystem")
+    void CompactSave();
+
+    /** Save only changed items to a journal slot between full snapshots. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SaveSystem")
+    bool bIncrementalSaves = true;
+
+    /** Journal size (records) at which the next save compacts into a full snapshot. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SaveSystem", meta = (ClampMin = "1"))
+    int32 JournalCompactionThreshold = 2000;
+
+    /** Incremental saves between periodic compactions. 0 disables the periodic compaction. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SaveSystem", meta = (ClampMin = "0"))
+    int32 IncrementalSavesPerCompaction = 30;
+
+    /** Fired when a SaveWorld request has been written to the slot (or failed). */
+    UPROPERTY(BlueprintAssignable, Category = "SaveSystem")
+    FOnWorldSaveCompleted OnSaveCompleted;
+
     UFUNCTION(BlueprintCallable, Category = "SaveSystem")
     void LoadWorld();
 
+    /** LoadWorld, spawning items nearest to FocusLocation first (e.g. the spawn point behind a loading screen). */
+    UFUNCTION(BlueprintCallable, Category = "SaveSystem")
+    void LoadWorldAround(FVector FocusLocation);
+
     UFUNCTION(BlueprintImplementableEvent, Category = "SaveSystem")
     void OnLoadingCompleted();
 
     UFUNCTION(BlueprintImplementableEvent, Category = "SaveSystem")
     void OnLoadingProgress(float Percentage);
 
+    // --- POOLING ---
+
+    /** Reuse released item actors instead of destroying and respawning them. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pooling")
+    bool bUseActorPool = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pooling", meta = (ClampMin = "0"))
+    int32 MaxPooledActorsPerClass = 512;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pooling", meta = (ClampMin = "0"))
+    int32 MaxPooledActorsTotal = 4096;
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Pooling")
+    int32 PoolHits = 0;
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Pooling")
+    int32 PoolMisses = 0;
+
+    UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Pooling")
+    int32 PooledActorCount = 0;
+
+    /** Spawns a sandbox item, reusing a pooled actor of the same class when possible. */
+    UFUNCTION(BlueprintCallable, Category = "Pooling")
+    AActor* SpawnItem(USandboxItemData* ItemData, const FTransform& Transform);
+
+    /** Removes a sandbox item from the world, keeping the actor for reuse if the pool has room. */
+    UFUNCTION(BlueprintCallable, Category = "Pooling")
+    void ReleaseItem(AActor* Actor);
+
+    /** Destroys every pooled actor. */
+    UFUNCTION(BlueprintCallable, Category = "Pooling")
+    void EmptyActorPool();
+
+    // --- BATCH SPAWNING ---
+
+    /**
+     * Queues items (stamps, arrays, pasted selections) for spawning under the load frame budget.
+     * An unloaded actor class is loaded asynchronously first, its items join the queue once it arrives.
+     * Returns the number queued. Queued items not yet spawned are dropped by LoadWorld.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Spawning")
+    int32 QueueItemSpawns(USandboxItemData* ItemData, const TArray<FTransform>& Transforms);
+
+    UFUNCTION(BlueprintPure, Category = "Spawning")
+    int32 GetQueuedSpawnCount() const { return SpawnQueue.Num() - SpawnQueueCursor + PendingClassSpawns.Num(); }
+
+    /** Fired when the spawn queue has drained. */
+    UFUNCTION(BlueprintImplementableEvent, Category = "Spawning")
+    void OnQueuedSpawnsCompleted();
+
+    // --- INSTANCING ---
+
+    /** Collapse resting static items whose data allows it into instanced mesh batches. Simulating and frozen bodies stay actors. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Instancing")
+    bool bInstanceRestingItems = true;
+
+    /** Seconds between collapse passes. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Instancing", meta = (ClampMin = "0.1"))
+    float InstancingInterval = 2.0f;
+
+    /** Upper bound on actors collapsed per pass, keeps the pass cheap. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Instancing", meta = (ClampMin = "1"))
+    int32 MaxCollapsesPerPass = 256;
+
+    /** A promoted item stays an actor at least this long (seconds). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Instancing", meta = (ClampMin = "0.0"))
+    float PromotionCooldown = 10.0f;
+
+    UFUNCTION(BlueprintPure, Category = "Instancing")
+    int32 GetInstancedItemCount() const;
+
+    /** Turns the instance a trace hit back into a full actor. Returns nullptr if the hit is not an instanced item. */
+    UFUNCTION(BlueprintCallable, Category = "Instancing")
+    AActor* PromoteInstancedHit(const FHitResult& Hit);
+
+    /** True if the hit is on an instanced item, without promoting it. */
+    UFUNCTION(BlueprintPure, Category = "Instancing")
+    bool IsInstancedItemHit(const FHitResult& Hit) const;
+
 private:
     bool bIsLoading = false;
+    bool bIsPreloading = false;
     int32 CurrentLoadIndex = 0;
 
+    // --- FRAME BUDGET ---
+
+    /** Smoothed frame time and the share of it the load loop used last frame. */
+    double SmoothedFrameTime = 0.0;
+    double LastLoadSliceTime = 0.0;
+
+    /** Smoothed cost of one spawned item, drives how often the clock is read. */
+    double SmoothedItemCost = 0.0;
+
+    double ComputeLoadFrameBudget(float DeltaTime);
+
+    // --- LOAD ORDER ---
+
+    /** Items of one grid cell, spawned together. */
+    struct FLoadCell
+    {
+        FVector Center = FVector::ZeroVector;
+        TArray<int32> ItemIndices;
+        int32 NextItem = 0;
+    };
+
+    /** Cells of the level being loaded; [CurrentLoadCell, end) is sorted nearest first. */
+    TArray<FLoadCell> LoadCells;
+    int32 CurrentLoadCell = 0;
+
+    bool bHasLoadFocusOverride = false;
+    FVector LoadFocusOverride = FVector::ZeroVector;
+    FVector LastLoadFocus = FVector::ZeroVector;
+
+    /** Player pawn, else the saved player transform. */
+    FVector GetLoadFocusLocation() const;
+
+    /** Buckets the level's items into grid cells sorted by distance to the focus. */
+    void BuildLoadCells(const TArray<FSavedItemCompact>& LevelItems);
+
+    /** Re-sorts the undrained cells if the player moved far enough. */
+    void UpdateLoadPriority();
+
+    /** Index into the level's items of the next one to spawn. */
+    int32 NextLoadItemIndex();
+
+    int32 GetItemsPerClockCheck(double FrameBudget) const;
+    void RecordLoadSlice(double Elapsed, int32 ItemsSpawned);
+
+    /** Spawns a saved item from the preloaded asset caches. */
+    AActor* SpawnSavedItem(const FSavedItemCompact& ItemData, bool bHoldPhysics);
+
+    void CompleteLoading();
+
+    // --- STREAMING ---
+
+    bool bStreamingActive = false;
+    FString StreamedLevelName;
+
+    TSet<FIntPoint> StreamedCells;
+
+    /** Saved items by the cell of their saved position. Live items are re-bucketed when they stream out. */
+    TMap<FIntPoint, TArray<int32>> SavedItemIdsByCell;
+    TMap<int32, FIntPoint> SavedCellByItemId;
+
+    /** Ids spawned (or queued for spawning) from the save. */
+    TSet<int32> StreamedLiveIds;
+
+    TArray<int32> StreamSpawnQueue;
+    int32 StreamSpawnCursor = 0;
+    int32 StreamInitialQueueCount = 0;
+
+    FVector LastStreamingFocus = FVector::ZeroVector;
+
+    FIntPoint GetStreamingCell(const FVector& Location) const;
+    double GetStreamingCellDistance(const FIntPoint& Cell, const FVector& Location) const;
+
+    /** Indexes the current level block and queues the cells around the load focus. */
+    void StartStreaming();
+    void StopStreaming();
+
+    void IndexStreamedItem(int32 ItemId, const FIntPoint& Cell);
+
+    /** Unloads cells past radius + hysteresis and queues newly entered ones. */
+    void UpdateStreamedCells(const FVector& Focus, bool bForce);
+
+    /** Writes live items outside every loaded cell back to the working save and pools their actors. */
+    void StreamOutItems();
+
+    void WriteBackStreamedItem(FSavedLevelData& Level, const FSavedItemCompact& Item);
+
+    void TickStreaming(double FrameBudget);
+
+    /** In-flight loads of palette entries met while streaming (added after the preload). */
+    TMap<int32, TSharedPtr<FStreamableHandle>> PaletteLoadHandles;
+
+    /** Streamed items waiting for their palette entry, queued again once it resolves. */
+    TMap<int32, TArray<int32>> DeferredStreamIds;
+
+    /** Starts an async load of the palette entry's data asset and then its actor class. */
+    void RequestPaletteEntry(int32 PaletteIndex);
+    void OnPaletteDataLoaded(int32 PaletteIndex);
+    void OnPaletteClassLoaded(int32 PaletteIndex);
+
+    /** Index of the current level's block in CachedSaveGame->Levels. */
+    int32 CachedLevelIndex = INDEX_NONE;
+
+    /** Palette entries referenced by the level being loaded. */
+    TArray<int32> PreloadPaletteIndices;
+
+    // Streamable handles keep preloaded assets resident until spawning is done
+    TSharedPtr<FStreamableHandle> DataAssetPreloadHandle;
+    TSharedPtr<FStreamableHandle> ClassPreloadHandle;
+
+    /** Requests all palette data assets used by the current level in one batch. */
+    void StartAssetPreload();
+
+    /** Data assets are resident: request the actor classes they reference. */
+    void OnDataAssetsPreloaded();
+
+    /** Actor classes are resident: fill caches and start the spawn phase. */
+    void OnActorClassesPreloaded();
+
+    void CancelAssetPreload();
+
+    /** Pools (or destroys) the actor. bRemoveFromSave records the item's removal for the next save. */
+    void PoolItemActor(AActor* Actor, bool bRemoveFromSave);
+
+    /** bHoldPhysics parks the actor's bodies per LoadPhysicsMode until ReleaseHeldPhysics. */
+    AActor* AcquireItemActor(UClass* ActorClass, USandboxItemData* ItemData, const FTransform& Transform, int32 ItemId, bool bHoldPhysics, const FSavedPhysicsState* SavedPhysics = nullptr);
+
+    /** SpawnActorDeferred path: identity is initialized before FinishSpawning. */
+    AActor* SpawnItemActorDeferred(UClass* ActorClass, USandboxItemData* ItemData, const FTransform& Transform, int32 ItemId, bool bHoldPhysics);
+
+    void InitializeItemIdentity(USandboxIdentityComponent* Identity, USandboxItemData* ItemData, int32 ItemId);
+
+    void DeactivatePooledActor(AActor* Actor);
+    void ReactivatePooledActor(AActor* Actor, const FTransform& Transform, bool bEnableCollision);
+
+    /** Wakes (or creates bodies for) every actor placed during the load, in one pass. */
+    void ReleaseHeldPhysics();
+
+    UPROPERTY()
+    TMap<TObjectPtr<UClass>, FSandboxActorPoolBucket> ActorPool;
+
+    /** Classes whose construction already provides a USandboxIdentityComponent. */
+    UPROPERTY()
+    TMap<TObjectPtr<UClass>, bool> ClassProvidesIdentity;
+
+    UPROPERTY()
+    TArray<TObjectPtr<AActor>> HeldPhysicsActors;
+
+    // --- BATCH SPAWN QUEUE ---
+
+    UPROPERTY()
+    TArray<FSandboxQueuedSpawn> SpawnQueue;
+
+    int32 SpawnQueueCursor = 0;
+
+    /** Spawns queued items until FrameBudget runs out. */
+    void TickSpawnQueue(double FrameBudget);
+
+    /** Queued items whose actor class is still loading (ActorClass is null until it resolves). */
+    UPROPERTY()
+    TArray<FSandboxQueuedSpawn> PendingClassSpawns;
+
+    /** In-flight actor class loads requested by QueueItemSpawns. */
+    TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> ClassLoadHandles;
+
+    void OnQueuedClassLoaded(FSoftObjectPath ClassPath);
+
+    /** Cancels the class loads of QueueItemSpawns and drops the items waiting on them. */
+    void CancelQueuedClassLoads();
+
+    /** Saved physics state per held actor, applied when the batch is released. */
+    TArray<FSavedPhysicsState> HeldPhysicsStates;
+
+    /** Transform plus (if bSavePhysicsState) sleep state and velocities of a live item. */
+    void CaptureItemState(const AActor* Actor, FSavedItemCompact& OutItem) const;
+
+    void ApplyPhysicsState(AActor* Actor, const FSavedPhysicsState& Physics) const;
+
+    // --- INSTANCING ---
+
+    UPROPERTY()
+    TMap<TObjectPtr<USandboxItemData>, FSandboxInstanceBatch> InstanceBatches;
+
+    /** Promotion time per promoted actor, for PromotionCooldown. */
+    TMap<TWeakObjectPtr<AActor>, double> PromotionTimes;
+
+    FTimerHandle InstancingTimerHandle;
+
+    /** Collapses clean, resting, instancing-enabled items. */
+    void CollapseRestingItems();
+
+    bool TryCollapseItem(USandboxIdentityComponent* Identity);
+
+    AActor* PromoteInstance(USandboxItemData* ItemData, FSandboxInstanceBatch& Batch, int32 InstanceIndex);
+
+    /** Removes one instance and its record, mirroring the component's index remapping. */
+    void RemoveInstanceAt(FSandboxInstanceBatch& Batch, int32 InstanceIndex);
+
+    void ClearInstanceBatches();
+
+    // --- ASYNC SAVE ---
+
+    enum class ESaveStage : uint8
+    {
+        Idle,
+        LoadingSlot,    // Reading the existing slot in the background
+        Encoding,       // Snapshot is being packed on a worker
+        Writing         // AsyncSaveGameToSlot in progress
+    };
+
+    ESaveStage SaveStage = ESaveStage::Idle;
+    bool bSaveQueued = false;
+    bool bLoadQueued = false;
+
+    /** True when the write in flight targets the journal slot rather than the base slot. */
+    bool bWritingJournal = false;
+
+    /** True once a load or full snapshot made the registry's dirty tracking authoritative. */
+    bool bWorldMatchesSave = false;
+
+    bool bCompactionRequested = false;
+    int32 IncrementalSavesSinceCompaction = 0;
+
+    /** Incremented to drop results of saves superseded by a synchronous flush. */
+    uint32 SaveGeneration = 0;
+
+    /** Items streamed out while a snapshot was encoding; the snapshot predates them and they are re-applied to it. */
+    TMap<int32, FSavedItemCompact> EncodingWriteBacks;
+
+    FString GetJournalSlotName() const;
+
+    void OnWorkingSaveLoaded(const FString& SlotName, const int32 UserIndex, USaveGame* LoadedSave);
+    void OnWorkingJournalLoaded(const FString& SlotName, const int32 UserIndex, USaveGame* LoadedJournal);
+
+    /** Synchronously reads the base slot and replays its journal. */
+    void LoadWorkingSaveBlocking();
+
+    /** Installs base + journal as the working save; creates fresh objects for missing ones. */
+    void AdoptWorkingSave(USandboxSaveGame* Base, USandboxSaveJournal* Journal);
+
+    int32 ResolvePaletteIndex(USandboxItemData* ItemData);
+
+    /** Chooses between an incremental journal write and a full snapshot. */
+    void BeginSave();
+
+    /** Game thread: writes only items changed since the last save to the journal slot. */
+    void BeginIncrementalSave();
+
+    /** Game thread: captures the level and hands it to a worker for encoding. */
+    void BeginSaveSnapshot();
+
+    /** Copies identity-bearing actors of the current level into a level block. */
+    void CaptureLevelSnapshot(FSavedLevelData& OutSnapshot);
+
+    /** Game thread: swaps the encoded snapshot into the working save and writes it. */
+    void CommitSaveSnapshot(FSavedLevelData&& Snapshot, uint32 Generation);
+
+    void OnAsyncSaveFinished(const FString& SlotName, const int32 UserIndex, bool bSuccess);
+
+    void OnFullSaveWritten();
+
+    void FinishSave(bool bSuccess);
+
+    /** Marks the freshly loaded world as the baseline for dirty tracking. */
+    void FinishLoadTracking();
+
+    /** Blocking save, used to flush pending work when the manager is torn down. */
+    void SaveWorldImmediate();
+
+    /** In-memory copy of the slot, kept so saves don't have to re-read the file. */
+    UPROPERTY()
+    TObjectPtr<USandboxSaveGame> WorkingSaveGame;
+
+    /** Changes written since WorkingSaveGame's last full save. */
+    UPROPERTY()
+    TObjectPtr<USandboxSaveJournal> WorkingJournal;
+
+    /** Base slot read in the background, held until its journal arrives. */
+    UPROPERTY()
+    TObjectPtr<USandboxSaveGame> PendingBaseSave;
+
+    UPROPERTY()
+    TMap<TObjectPtr<USandboxItemData>, int32> PaletteIndexCache;
+
     UPROPERTY()
     TObjectPtr<USandboxSaveGame> CachedSaveGame;
 